@@ -3,11 +3,20 @@
 
 
 #include "Block.h"
+#include "TheLighter.h"
 #include "TheLighterBall.h"
+#include "LighterBlockSubsystem.h"
+#include "LighterCollision.h"
+#include "LighterLitVisuals.h"
 
 #pragma region CORE
 ABlock::ABlock()
 {
+	// The LighterBlockSubsystem drives the collision updates
+	// So idle blocks don't need to tick at all
+	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
 	MeshComp = GetStaticMeshComponent();
 	MeshComp->SetCollisionProfileName(FName("LighterBlock"));
 	MeshComp->SetGenerateOverlapEvents(true);
@@ -23,36 +32,52 @@ ABlock::ABlock()
 
 
 #pragma region EVENTS
-void ABlock::Tick(float DeltaSeconds)
+void ABlock::BeginPlay()
 {
-	Super::Tick(DeltaSeconds);
+	Super::BeginPlay();
+
+	// Both collision states, built off whatever the profile gave us
+	CollisionResponses.Init(MeshComp->BodyInstance.GetResponseToChannels());
+
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+	{
+		subsystem->RegisterBlock(this);
+		StreamingUnit = subsystem->RegisterStreamingUnit(this, nullptr, GetBounds2D());
+	}
+}
 
-	// Don't update the collision preset
-	// Until the PlayerBall exits the collider
+void ABlock::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+	{
+		subsystem->UnregisterStreamingUnit(StreamingUnit);
+		subsystem->UnregisterBlock(this);
+	}
+	StreamingUnit = INDEX_NONE;
 
-	TArray<AActor*> overlappingActors;
-	MeshComp->GetOverlappingActors(overlappingActors);
-	if (CurrentCollisionResponse != TargetCollisionResponse && !overlappingActors.Contains(GetWorld()->GetFirstPlayerController()->GetPawn()))
-		SetCollisionMode(TargetCollisionResponse);
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABlock::OnComponentEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
 {
+	LIGHTER_INC_COUNTER(STAT_LighterOverlapEvents, 1);
+
 	UWorld* world = GetWorld();
 	if (!world) return;
 
-	APlayerController* playerController = world->GetFirstPlayerController();
-	if (!playerController) return;
-
-	APawn* playerPawn = playerController->GetPawn();
-	if (playerPawn && OtherActor == playerPawn)
+	// Any ball, not just the first player's
+	ATheLighterBall* playerBall = Cast<ATheLighterBall>(OtherActor);
+	if (playerBall)
 	{
+		// The ball is out
+		// Wake the block up if it's been waiting on a collision change
+		if (ULighterBlockSubsystem* subsystem = world->GetSubsystem<ULighterBlockSubsystem>())
+			subsystem->OnBallEndOverlap(BlockIndex);
 
 		// Apply an Impulse to the PlayerBall after it exits
 		// This allows us to do the HotWheels-Booster effect on the ball
 		// When it passes through a series of LighterBlocks placed close to each other
-
-		ATheLighterBall* playerBall = Cast<ATheLighterBall>(playerPawn);
+		// (Queued, every exit of the frame goes out as ONE impulse)
 		playerBall->ApplyExitImpulse();
 	}
 }
@@ -68,13 +93,88 @@ void ABlock::OnComponentEndOverlap(UPrimitiveComponent* OverlappedComp, AActor*
 
 
 #pragma region COLLISION
-void ABlock::SetCollisionMode(const ECollisionResponse CollisionResponse)
+bool ABlock::IsOverlappedByBall(const ATheLighterBall* Ball) const
+{
+	return MeshComp->IsOverlappingActor(Ball);
+}
+
+void ABlock::SetLitVisual(const FVector4& Fade)
+{
+	// All four in ONE call => ONE render state update
+	MeshComp->SetCustomPrimitiveDataVector4(LighterLitVisuals::From, Fade);
+}
+
+FBox2D ABlock::GetBounds2D() const
+{
+	const FBox bounds = MeshComp->Bounds.GetBox();
+	return FBox2D(ToLighterPlane(bounds.Min), ToLighterPlane(bounds.Max));
+}
+
+void ABlock::SetDormant(const bool bDormant)
+{
+	// The subsystem has already forgotten its lit state => Go back to an unlit PassThrough block
+	// Unregistering lets go of the physics body & the render state, only the actor itself stays around
+	if (bDormant)
+	{
+		if (!MeshComp->IsRegistered()) return;
+
+		SetCollisionMode(ECR_Overlap);
+		SetLitVisual(FVector4(0.f, 0.f, 0.f, 0.f));
+		MeshComp->UnregisterComponent();
+	}
+	else if (!MeshComp->IsRegistered())
+	{
+		MeshComp->RegisterComponent();
+	}
+}
+
+void ABlock::Relocate(const FVector& Location)
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (subsystem)
+	{
+		subsystem->UnregisterStreamingUnit(StreamingUnit);
+		subsystem->UnregisterBlock(this);
+	}
+	StreamingUnit = INDEX_NONE;
+
+	// Same state a freshly spawned block starts in
+	SetCollisionMode(ECR_Overlap);
+	SetLitVisual(FVector4(0.f, 0.f, 0.f, 0.f));
+
+	// Streaming may have put it to sleep where it was, the new spot decides again
+	SetActorLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+	SetDormant(false);
+
+	if (subsystem)
+	{
+		subsystem->RegisterBlock(this);
+		StreamingUnit = subsystem->RegisterStreamingUnit(this, nullptr, GetBounds2D());
+	}
+}
+
+void ABlock::Shift(const FVector& Offset)
 {
-	UStaticMeshComponent* meshComp = GetStaticMeshComponent();
+	SetActorLocation(GetActorLocation() + Offset, false, nullptr, ETeleportType::TeleportPhysics);
+
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+		subsystem->ShiftBlock(this, Offset);
+}
 
-	meshComp->SetCollisionResponseToChannel(ECC_Pawn, CollisionResponse);
-	meshComp->SetCollisionResponseToChannel(ECC_PhysicsBody, CollisionResponse);
+void ABlock::SetCollisionMode(const ECollisionResponse CollisionResponse)
+{
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterBlockSetCollisionMode);
+	LIGHTER_INC_COUNTER(STAT_LighterCollisionToggles, 1);
 
-	CurrentCollisionResponse = CollisionResponse;
+	if (LighterCollision::UseFastToggle())
+	{
+		// ONE filter update, no collision-settings-changed fallout
+		MeshComp->BodyInstance.SetResponseToChannels(CollisionResponses.Get(CollisionResponse));
+	}
+	else
+	{
+		MeshComp->SetCollisionResponseToChannel(ECC_Pawn, CollisionResponse);
+		MeshComp->SetCollisionResponseToChannel(ECC_PhysicsBody, CollisionResponse);
+	}
 }
 #pragma endregion
\ No newline at end of file
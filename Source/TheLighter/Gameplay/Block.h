@@ -5,6 +5,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/StaticMeshActor.h"
+#include "LighterCollision.h"
 #include "Block.generated.h"
 
 /**
@@ -24,19 +25,24 @@ public:
 		class UStaticMeshComponent* MeshComp;
 #pragma endregion
 
-	
 
-	
+
+
 #pragma region COLLISION
 private:
+	// Solid & PassThrough, pre-built on BeginPlay
+	FLighterCollisionResponses CollisionResponses;
 
-	// This function is used to provide a LateUpdate to the LighterBlock's collision preset
-	ECollisionResponse CurrentCollisionResponse;
-	void SetCollisionMode(const ECollisionResponse CollisionResponse);
-	
 public:
-	// This is the collision preset we want
-	ECollisionResponse TargetCollisionResponse;
+	// Current & target responses live in the LighterBlockSubsystem's store
+	// It calls this once NOTHING's overlapping the LighterBlock anymore (LateUpdate of the collision preset)
+	void SetCollisionMode(const ECollisionResponse CollisionResponse);
+
+	// Checked by the LighterBlockSubsystem before it applies a change
+	bool IsOverlappedByBall(const class ATheLighterBall* Ball) const;
+
+	// Lit fade into the custom primitive data (See LighterLitVisuals.h)
+	void SetLitVisual(const FVector4& Fade);
 
 	// Overriding the EndOverlap so we could update the collision preset after the ball exits
 	UFUNCTION()
@@ -45,9 +51,36 @@ public:
 
 
 
-	
+
+#pragma region SUBSYSTEM
+public:
+	// Slot in the LighterBlockSubsystem (Stable while the block is registered)
+	int32 BlockIndex = INDEX_NONE;
+
+	// Mesh bounds flattened onto the YZ plane (For the LighterBlockGrid)
+	FBox2D GetBounds2D() const;
+
+	// Streaming unit in the LighterBlockSubsystem
+	int32 StreamingUnit = INDEX_NONE;
+
+	// DORMANT => Component unregistered, so no physics body & no render state (Far from the PlayerBall)
+	void SetDormant(const bool bDormant);
+
+	// Pooled blocks => Leave the subsystem, move, come back as a fresh unlit PassThrough block
+	// (Recycling only, a live block that has to move with the world gets Shifted instead)
+	void Relocate(const FVector& Location);
+
+	// Rebase => Moves by Offset IN PLACE, still registered
+	// Lit count, response & lit visual carry over, so a ball standing on it keeps standing on it
+	void Shift(const FVector& Offset);
+#pragma endregion
+
+
+
+
 #pragma region EVENTS
 public:
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 #pragma endregion
 };
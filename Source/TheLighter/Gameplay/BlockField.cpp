@@ -0,0 +1,215 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Many LighterBlocks in ONE actor
+
+#include "BlockField.h"
+#include "TheLighter.h"
+#include "TheLighterBall.h"
+#include "LighterBlockSubsystem.h"
+#include "LighterCollision.h"
+#include "LighterLitVisuals.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+#pragma region CORE
+ABlockField::ABlockField()
+{
+	// The LighterBlockSubsystem drives the collision updates
+	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	InstancedMeshComp = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("InstancedMesh0"));
+	InstancedMeshComp->SetCollisionProfileName(FName("LighterBlock"));
+	InstancedMeshComp->SetGenerateOverlapEvents(true);
+	InstancedMeshComp->bMultiBodyOverlap = true;		// Overlaps report the instance as the body index
+	InstancedMeshComp->SetMobility(EComponentMobility::Stationary);
+	InstancedMeshComp->NumCustomDataFloats = LighterLitVisuals::Num;
+	RootComponent = InstancedMeshComp;
+}
+#pragma endregion
+
+
+
+
+
+
+
+#pragma region EVENTS
+void ABlockField::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Per instance state lives in the LighterBlockSubsystem's store, keyed by these
+	const int32 numInstances = InstancedMeshComp->GetInstanceCount();
+	InstanceBlockIndices.Init(INDEX_NONE, numInstances);
+
+	// Fields placed before the lit fades existed have no custom data yet
+	if (InstancedMeshComp->NumCustomDataFloats != LighterLitVisuals::Num || InstancedMeshComp->PerInstanceSMCustomData.Num() != numInstances * LighterLitVisuals::Num)
+	{
+		InstancedMeshComp->NumCustomDataFloats = LighterLitVisuals::Num;
+		InstancedMeshComp->PerInstanceSMCustomData.SetNumZeroed(numInstances * LighterLitVisuals::Num);
+		InstancedMeshComp->MarkRenderStateDirty();
+	}
+
+	// Every instance body starts off the component's responses
+	CollisionResponses.Init(InstancedMeshComp->BodyInstance.GetResponseToChannels());
+
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+	{
+		FBox2D fieldBounds(ForceInit);
+		for (int32 i = 0; i < numInstances; ++i)
+		{
+			const FBox2D instanceBounds = GetInstanceBounds2D(i);
+			InstanceBlockIndices[i] = subsystem->RegisterInstance(this, i, instanceBounds);
+			fieldBounds += instanceBounds;
+		}
+		StreamingUnit = subsystem->RegisterStreamingUnit(nullptr, this, fieldBounds);
+	}
+}
+
+void ABlockField::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+	{
+		subsystem->UnregisterStreamingUnit(StreamingUnit);
+		for (const int32 blockIndex : InstanceBlockIndices)
+			subsystem->UnregisterInstance(blockIndex);
+	}
+	InstanceBlockIndices.Reset();
+	StreamingUnit = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ABlockField::OnInstanceEndOverlap(const int32 InstanceIndex, AActor* OtherActor)
+{
+	if (!InstanceBlockIndices.IsValidIndex(InstanceIndex)) return;
+	LIGHTER_INC_COUNTER(STAT_LighterOverlapEvents, 1);
+
+	// Same deal as ABlock::OnComponentEndOverlap
+	// Wake the instance up, then give the PlayerBall its ExitImpulse
+
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+		subsystem->OnBallEndOverlap(InstanceBlockIndices[InstanceIndex]);
+
+	if (ATheLighterBall* playerBall = Cast<ATheLighterBall>(OtherActor))
+		playerBall->ApplyExitImpulse();
+}
+#pragma endregion
+
+
+
+
+
+
+
+
+
+
+#pragma region COLLISION
+void ABlockField::SetInstanceLitVisual(const int32 InstanceIndex, const FVector4& Fade)
+{
+	InstancedMeshComp->SetCustomDataValue(InstanceIndex, LighterLitVisuals::From, Fade.X, false);
+	InstancedMeshComp->SetCustomDataValue(InstanceIndex, LighterLitVisuals::To, Fade.Y, false);
+	InstancedMeshComp->SetCustomDataValue(InstanceIndex, LighterLitVisuals::StartTime, Fade.Z, false);
+	InstancedMeshComp->SetCustomDataValue(InstanceIndex, LighterLitVisuals::Duration, Fade.W, false);
+}
+
+void ABlockField::FlushLitVisuals()
+{
+	InstancedMeshComp->MarkRenderStateDirty();
+}
+
+bool ABlockField::IsInstanceLit(const int32 InstanceIndex) const
+{
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	return subsystem && subsystem->IsBlockLit(GetBlockIndex(InstanceIndex));
+}
+
+bool ABlockField::IsInstanceOverlappedByBall(const int32 InstanceIndex, const ATheLighterBall* Ball) const
+{
+	// The ball's overlap list knows which instance (Item) it's inside
+	const UPrimitiveComponent* pawnComp = Cast<UPrimitiveComponent>(Ball->GetRootComponent());
+	if (!pawnComp) return false;
+
+	for (const FOverlapInfo& overlap : pawnComp->GetOverlapInfos())
+		if (overlap.OverlapInfo.Component.Get() == InstancedMeshComp && overlap.GetBodyIndex() == InstanceIndex)
+			return true;
+
+	return false;
+}
+
+void ABlockField::SetInstanceCollisionMode(const int32 InstanceIndex, const ECollisionResponse CollisionResponse)
+{
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterBlockSetCollisionMode);
+	LIGHTER_INC_COUNTER(STAT_LighterCollisionToggles, 1);
+
+	// Every instance has its own body, so only this one block changes
+	FBodyInstance* body = InstancedMeshComp->InstanceBodies.IsValidIndex(InstanceIndex) ? InstancedMeshComp->InstanceBodies[InstanceIndex] : nullptr;
+	if (!body) return;
+
+	if (LighterCollision::UseFastToggle())
+	{
+		// ONE filter update (Same pre-built container as ABlock)
+		body->SetResponseToChannels(CollisionResponses.Get(CollisionResponse));
+	}
+	else
+	{
+		body->SetResponseToChannel(ECC_Pawn, CollisionResponse);
+		body->SetResponseToChannel(ECC_PhysicsBody, CollisionResponse);
+	}
+}
+#pragma endregion
+
+
+
+
+
+
+
+
+
+
+#pragma region SUBSYSTEM
+void ABlockField::SetDormant(const bool bDormant)
+{
+	// Unregistering lets go of every instance body & the render state
+	// The instance transforms stay, they're all it takes to come back
+	if (bDormant)
+	{
+		if (!InstancedMeshComp->IsRegistered()) return;
+
+		// The subsystem has already forgotten their lit state
+		const FVector4 unlit(0.f, 0.f, 0.f, 0.f);
+		for (int32 i = 0; i < InstanceBlockIndices.Num(); ++i)
+			SetInstanceLitVisual(i, unlit);
+
+		InstancedMeshComp->UnregisterComponent();
+		return;
+	}
+
+	if (InstancedMeshComp->IsRegistered()) return;
+	InstancedMeshComp->RegisterComponent();
+
+	// Fresh instance bodies come off the component's responses
+	// Put back every instance that got lit while it was asleep (A checkpoint restore can do that)
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem) return;
+
+	for (int32 i = 0; i < InstanceBlockIndices.Num(); ++i)
+		if (subsystem->IsBlockSolid(InstanceBlockIndices[i]))
+			if (FBodyInstance* body = InstancedMeshComp->InstanceBodies.IsValidIndex(i) ? InstancedMeshComp->InstanceBodies[i] : nullptr)
+				body->SetResponseToChannels(CollisionResponses.Get(ECR_Block));
+}
+
+FBox2D ABlockField::GetInstanceBounds2D(const int32 InstanceIndex) const
+{
+	const UStaticMesh* mesh = InstancedMeshComp->GetStaticMesh();
+	FTransform instanceTransform;
+	if (!mesh || !InstancedMeshComp->GetInstanceTransform(InstanceIndex, instanceTransform, true))
+		return FBox2D(ForceInit);
+
+	const FBox bounds = mesh->GetBounds().GetBox().TransformBy(instanceTransform);
+	return FBox2D(ToLighterPlane(bounds.Min), ToLighterPlane(bounds.Max));
+}
+#pragma endregion
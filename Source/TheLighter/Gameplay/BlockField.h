@@ -0,0 +1,94 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Many LighterBlocks in ONE actor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LighterCollision.h"
+#include "BlockField.generated.h"
+
+
+/*
+* An ABlock is a full actor => Own component, own physics body, own overlap tracking
+* That caps how dense the light puzzles can get
+*
+* ABlockField holds any number of LighterBlocks as instances of ONE HISM component
+* 		a. Each instance gets its own BlockIndex in the LighterBlockSubsystem
+* 		b. Lit & collision state is stored PER INSTANCE (In the subsystem's FLighterBlockStore)
+* 		c. Collision gets toggled on the instance's own physics body
+*
+* NOTE: Place the instances in the editor, they're registered once on BeginPlay
+*/
+
+UCLASS(config=Game)
+class ABlockField : public AActor
+{
+	GENERATED_BODY()
+
+#pragma region CORE
+public:
+	ABlockField();
+
+	// Every LighterBlock of the field lives in here
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		class UHierarchicalInstancedStaticMeshComponent* InstancedMeshComp;
+#pragma endregion
+
+
+
+
+#pragma region COLLISION
+public:
+	// Same LateUpdate as ABlock, just per instance (Called by the LighterBlockSubsystem)
+	void SetInstanceCollisionMode(const int32 InstanceIndex, const ECollisionResponse CollisionResponse);
+	bool IsInstanceOverlappedByBall(const int32 InstanceIndex, const class ATheLighterBall* Ball) const;
+
+	// Lit fade into the instance's custom data (See LighterLitVisuals.h)
+	// Render state is only marked dirty on FlushLitVisuals(), once for every instance written that frame
+	void SetInstanceLitVisual(const int32 InstanceIndex, const FVector4& Fade);
+	void FlushLitVisuals();
+
+	// Lit => At least one emitter wants the instance solid
+	UFUNCTION(BlueprintCallable, Category = "LighterBlock")
+		bool IsInstanceLit(const int32 InstanceIndex) const;
+
+	// The PlayerBall reports these, since only it knows which instance it just left
+	void OnInstanceEndOverlap(const int32 InstanceIndex, class AActor* OtherActor);
+
+private:
+	// Shared by every instance (They all come off the same component)
+	FLighterCollisionResponses CollisionResponses;
+#pragma endregion
+
+
+
+
+#pragma region SUBSYSTEM
+public:
+	FORCEINLINE int32 GetBlockIndex(const int32 InstanceIndex) const { return InstanceBlockIndices.IsValidIndex(InstanceIndex) ? InstanceBlockIndices[InstanceIndex] : INDEX_NONE; }
+
+	// Instance bounds flattened onto the YZ plane (For the LighterBlockGrid)
+	FBox2D GetInstanceBounds2D(const int32 InstanceIndex) const;
+
+	FORCEINLINE const TArray<int32>& GetBlockIndices() const { return InstanceBlockIndices; }
+
+	// DORMANT => Component unregistered, so no instance bodies & no render state (Far from the PlayerBall)
+	void SetDormant(const bool bDormant);
+
+private:
+	TArray<int32> InstanceBlockIndices;
+
+	// The whole field streams as ONE unit
+	int32 StreamingUnit = INDEX_NONE;
+#pragma endregion
+
+
+
+
+#pragma region EVENTS
+public:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+#pragma endregion
+};
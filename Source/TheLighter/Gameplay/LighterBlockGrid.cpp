@@ -0,0 +1,204 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// 2D spatial index for the LighterBlocks
+
+#include "LighterBlockGrid.h"
+
+
+
+////////////////////////////////////////////////////////////////////// CONE
+#pragma region CONE
+FLighterCone::FLighterCone(const FVector2D& InApex, const FVector2D& InDirection, const float InHalfAngleDegrees, const float InRange)
+	: Apex(InApex)
+	, Direction(InDirection.GetSafeNormal())
+	, HalfAngle(FMath::DegreesToRadians(FMath::Clamp(InHalfAngleDegrees, 0.f, 180.f)))
+	, Range(FMath::Max(InRange, 0.f))
+{
+}
+
+
+
+/*
+* A wedge with HalfAngle <= 90deg is CONVEX
+* It's just the overlap of the two half-planes that hug its edges
+*
+* 1. Clip the box against both half-planes	=> Convex polygon (Box ∩ Wedge)
+* 2. If nothing's left						=> No hit
+* 3. Otherwise the closest point of that polygon to the apex has to be within Range
+*
+* Wider cones get split into two convex halves
+*/
+
+static bool ConvexWedgeIntersectsBox(const FVector2D& Apex, const FVector2D& Direction, const float HalfAngle, const float Range, const FBox2D& Box)
+{
+	const FVector2D leftEdge = RotateVector2D(Direction, HalfAngle);
+	const FVector2D rightEdge = RotateVector2D(Direction, -HalfAngle);
+
+	FVector2D polygon[8] = { Box.Min, FVector2D(Box.Max.X, Box.Min.Y), Box.Max, FVector2D(Box.Min.X, Box.Max.Y) };
+	int32 numVertices = 4;
+
+	// Sutherland-Hodgman against "Inside => Distance <= 0"
+	auto clip = [&polygon, &numVertices, &Apex](const FVector2D& Edge, const float Sign)
+	{
+		FVector2D clipped[8];
+		int32 numClipped = 0;
+
+		for (int32 i = 0; i < numVertices; ++i)
+		{
+			const FVector2D& a = polygon[i];
+			const FVector2D& b = polygon[(i + 1) % numVertices];
+			const float da = Sign * (Edge ^ (a - Apex));
+			const float db = Sign * (Edge ^ (b - Apex));
+
+			if (da <= 0.f)
+				clipped[numClipped++] = a;
+			if ((da < 0.f && db > 0.f) || (da > 0.f && db < 0.f))
+				clipped[numClipped++] = a + (b - a) * (da / (da - db));
+		}
+
+		numVertices = numClipped;
+		for (int32 i = 0; i < numClipped; ++i)
+			polygon[i] = clipped[i];
+	};
+
+	clip(leftEdge, 1.f);
+	if (numVertices == 0) return false;
+	clip(rightEdge, -1.f);
+	if (numVertices == 0) return false;
+
+	// The apex sits on both clipping lines, so it's only inside the polygon if it's inside the box
+	if (Box.IsInside(Apex))
+		return true;
+
+	const float rangeSquared = Range * Range;
+	for (int32 i = 0; i < numVertices; ++i)
+	{
+		const FVector2D closest = FMath::ClosestPointOnSegment2D(Apex, polygon[i], polygon[(i + 1) % numVertices]);
+		if (FVector2D::DistSquared(Apex, closest) <= rangeSquared)
+			return true;
+	}
+	return false;
+}
+
+bool FLighterCone::Intersects(const FBox2D& Box) const
+{
+	if (!Box.bIsValid || Range <= 0.f)
+		return false;
+
+	if (HalfAngle <= HALF_PI)
+		return ConvexWedgeIntersectsBox(Apex, Direction, HalfAngle, Range, Box);
+
+	const float halfOfHalf = HalfAngle * 0.5f;
+	return ConvexWedgeIntersectsBox(Apex, RotateVector2D(Direction, halfOfHalf), halfOfHalf, Range, Box)
+		|| ConvexWedgeIntersectsBox(Apex, RotateVector2D(Direction, -halfOfHalf), halfOfHalf, Range, Box);
+}
+
+FBox2D FLighterCone::GetBounds() const
+{
+	FBox2D bounds(ForceInit);
+	bounds += Apex;
+	bounds += Apex + RotateVector2D(Direction, HalfAngle) * Range;
+	bounds += Apex + RotateVector2D(Direction, -HalfAngle) * Range;
+
+	// The arc bulges past its end points wherever it crosses an axis
+	const float cosHalfAngle = FMath::Cos(HalfAngle);
+	const FVector2D axes[4] = { FVector2D(1.f, 0.f), FVector2D(-1.f, 0.f), FVector2D(0.f, 1.f), FVector2D(0.f, -1.f) };
+	for (const FVector2D& axis : axes)
+		if ((axis | Direction) >= cosHalfAngle)
+			bounds += Apex + axis * Range;
+
+	return bounds;
+}
+#pragma endregion CONE
+////////////////////////////////////////////////////////////////////// CONE
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// GRID
+#pragma region GRID
+FLighterBlockGrid::FLighterBlockGrid(const float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.f))
+{
+}
+
+FIntPoint FLighterBlockGrid::GetCell(const FVector2D& Point) const
+{
+	return FIntPoint(FMath::FloorToInt(Point.X / CellSize), FMath::FloorToInt(Point.Y / CellSize));
+}
+
+void FLighterBlockGrid::Add(const int32 Id, const FBox2D& Bounds)
+{
+	check(Id >= 0);
+	if (Id >= QueryStamps.Num())
+		QueryStamps.SetNumZeroed(Id + 1);
+
+	const FIntPoint minCell = GetCell(Bounds.Min);
+	const FIntPoint maxCell = GetCell(Bounds.Max);
+	for (int32 y = minCell.X; y <= maxCell.X; ++y)
+		for (int32 z = minCell.Y; z <= maxCell.Y; ++z)
+			Cells.FindOrAdd(FIntPoint(y, z)).Add(Id);
+}
+
+void FLighterBlockGrid::Remove(const int32 Id, const FBox2D& Bounds)
+{
+	if (!Bounds.bIsValid) return;
+
+	const FIntPoint minCell = GetCell(Bounds.Min);
+	const FIntPoint maxCell = GetCell(Bounds.Max);
+	for (int32 y = minCell.X; y <= maxCell.X; ++y)
+		for (int32 z = minCell.Y; z <= maxCell.Y; ++z)
+		{
+			const FIntPoint cellKey(y, z);
+			if (TArray<int32>* cell = Cells.Find(cellKey))
+			{
+				cell->RemoveSingleSwap(Id, false);
+
+				// Empty cells go, so a level that keeps moving (Runner) doesn't keep every cell it ever touched
+				if (cell->Num() == 0)
+					Cells.Remove(cellKey);
+			}
+		}
+}
+
+void FLighterBlockGrid::QueryBox(const FBox2D& Box, const FLighterBlockStore& Store, TArray<int32>& OutIds) const
+{
+	if (!Box.bIsValid) return;
+
+	++QueryStamp;
+	const FIntPoint minCell = GetCell(Box.Min);
+	const FIntPoint maxCell = GetCell(Box.Max);
+
+	for (int32 y = minCell.X; y <= maxCell.X; ++y)
+	{
+		for (int32 z = minCell.Y; z <= maxCell.Y; ++z)
+		{
+			const TArray<int32>* cell = Cells.Find(FIntPoint(y, z));
+			if (!cell) continue;
+
+			for (const int32 id : *cell)
+			{
+				if (QueryStamps[id] == QueryStamp) continue;
+				QueryStamps[id] = QueryStamp;
+
+				if (Store.Intersects(id, Box))
+					OutIds.Add(id);
+			}
+		}
+	}
+}
+
+void FLighterBlockGrid::QueryCone(const FLighterCone& Cone, const FLighterBlockStore& Store, TArray<int32>& OutIds) const
+{
+	const int32 firstCandidate = OutIds.Num();
+	QueryBox(Cone.GetBounds(), Store, OutIds);
+
+	// Narrow phase => Drop every broad phase candidate the cone doesn't actually touch
+	for (int32 i = OutIds.Num() - 1; i >= firstCandidate; --i)
+		if (!Cone.Intersects(Store.GetBounds(OutIds[i])))
+			OutIds.RemoveAtSwap(i, 1, false);
+}
+#pragma endregion GRID
+////////////////////////////////////////////////////////////////////// GRID
@@ -0,0 +1,101 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// 2D spatial index for the LighterBlocks
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LighterBlockStore.h"
+
+
+/*
+* The PlayerBall is locked to the YZ plane (EDOFMode::YZPlane)
+* So everything the Tracer cares about lives in 2D
+*
+* 		World (X, Y, Z)		=>		Grid (Y, Z)
+*
+* NOTE: Use ToLighterPlane() to go from world space to grid space
+*/
+
+FORCEINLINE FVector2D ToLighterPlane(const FVector& WorldVector) { return FVector2D(WorldVector.Y, WorldVector.Z); }
+
+// Counter-clockwise, Angle in radians
+FORCEINLINE FVector2D RotateVector2D(const FVector2D& V, const float Angle)
+{
+	float s, c;
+	FMath::SinCos(&s, &c, Angle);
+	return FVector2D(V.X * c - V.Y * s, V.X * s + V.Y * c);
+}
+
+// Where a ray crosses the gameplay plane (X = PlaneX)
+// False if the ray runs parallel to it or points away from it
+FORCEINLINE bool IntersectLighterPlane(const FVector& RayOrigin, const FVector& RayDirection, const float PlaneX, FVector& OutLocation)
+{
+	if (FMath::IsNearlyZero(RayDirection.X))
+		return false;
+
+	const float distance = (PlaneX - RayOrigin.X) / RayDirection.X;
+	if (distance < 0.f)
+		return false;
+
+	OutLocation = RayOrigin + RayDirection * distance;
+	return true;
+}
+
+
+
+
+// The SpotLight's cone flattened onto the YZ plane
+// It's a circular sector => Apex, facing Direction, spreading HalfAngle to each side, Range long
+struct FLighterCone
+{
+	FVector2D Apex = FVector2D::ZeroVector;
+	FVector2D Direction = FVector2D(1.f, 0.f);		// Unit length
+	float HalfAngle = 0.f;							// Radians
+	float Range = 0.f;
+
+	FLighterCone() {}
+	FLighterCone(const FVector2D& InApex, const FVector2D& InDirection, const float InHalfAngleDegrees, const float InRange);
+
+	// Exact cone-vs-AABB test (No sampling, so thin blocks are never missed)
+	bool Intersects(const FBox2D& Box) const;
+
+	// Conservative AABB around the sector
+	FBox2D GetBounds() const;
+
+	FORCEINLINE bool Equals(const FLighterCone& Other) const
+	{
+		return Apex == Other.Apex && Direction == Other.Direction && HalfAngle == Other.HalfAngle && Range == Other.Range;
+	}
+};
+
+
+
+
+// Uniform grid over the YZ plane
+// Blocks are stored by their LighterBlockSubsystem index & inserted into every cell they touch
+// The bounds themselves live in the FLighterBlockStore, the grid only knows the cells
+class FLighterBlockGrid
+{
+public:
+	explicit FLighterBlockGrid(const float InCellSize = 400.f);
+
+	// Same Bounds for both (Blocks are Stationary)
+	void Add(const int32 Id, const FBox2D& Bounds);
+	void Remove(const int32 Id, const FBox2D& Bounds);
+
+	// Every id whose bounds touch the box (Broad phase only)
+	void QueryBox(const FBox2D& Box, const FLighterBlockStore& Store, TArray<int32>& OutIds) const;
+
+	// Every id whose bounds intersect the cone (Exact)
+	void QueryCone(const FLighterCone& Cone, const FLighterBlockStore& Store, TArray<int32>& OutIds) const;
+
+private:
+	FIntPoint GetCell(const FVector2D& Point) const;
+
+	float CellSize;
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	// Stamps avoid returning a block twice when it spans multiple cells
+	mutable TArray<uint32> QueryStamps;
+	mutable uint32 QueryStamp = 0;
+};
@@ -0,0 +1,99 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Set of LighterBlocks keyed by their LighterBlockSubsystem index
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+* Backs both the HITSET and the LITSET of the Tracer
+*
+* 		Bits	=> Dense bitset over ABlock::BlockIndex		(O(1) Contains)
+* 		Members	=> The indices that are actually in the set	(O(N) iteration, N = set size)
+* 		Positions	=> Where each member sits in Members			(O(1) swap-remove, only read while its bit is set)
+*
+* NOTE: Clearing only touches the member bits, so the cost never depends on the level size
+*/
+
+class FLighterBlockSet
+{
+public:
+	FORCEINLINE bool Contains(const int32 BlockIndex) const
+	{
+		return BlockIndex >= 0 && BlockIndex < Bits.Num() && Bits[BlockIndex];
+	}
+
+	// Returns false if it was already in
+	bool Add(const int32 BlockIndex)
+	{
+		check(BlockIndex >= 0);
+		if (BlockIndex >= Bits.Num())
+		{
+			const int32 grow = BlockIndex + 1 - Bits.Num();
+			Bits.Add(false, grow);
+			Positions.AddUninitialized(grow);
+		}
+
+		if (Bits[BlockIndex])
+			return false;
+
+		Bits[BlockIndex] = true;
+		Positions[BlockIndex] = Members.Add(BlockIndex);
+		return true;
+	}
+
+	// Returns false if it wasn't in
+	bool Remove(const int32 BlockIndex)
+	{
+		if (!Contains(BlockIndex))
+			return false;
+
+		// The last member fills the gap => Only its position changes
+		const int32 position = Positions[BlockIndex];
+		Bits[BlockIndex] = false;
+		Members.RemoveAtSwap(position, 1, false);
+		if (position < Members.Num())
+			Positions[Members[position]] = position;
+		return true;
+	}
+
+	void Reset()
+	{
+		for (const int32 blockIndex : Members)
+			Bits[blockIndex] = false;
+		Members.Reset();
+	}
+
+	FORCEINLINE int32 Num() const { return Members.Num(); }
+	FORCEINLINE const TArray<int32>& GetMembers() const { return Members; }
+
+	// Order-independent => Same members, same hash (Used to verify input replays)
+	uint32 GetHash() const
+	{
+		uint32 hash = Members.Num();
+		for (const int32 blockIndex : Members)
+			hash += HashCombine(GetTypeHash(blockIndex), 0x9E3779B9u);
+		return hash;
+	}
+
+
+	// ONE linear pass over both sets
+	// 		Added	=> In Next, not in this
+	// 		Removed	=> In this, not in Next
+	void Diff(const FLighterBlockSet& Next, TArray<int32>& OutAdded, TArray<int32>& OutRemoved) const
+	{
+		for (const int32 blockIndex : Next.Members)
+			if (!Contains(blockIndex))
+				OutAdded.Add(blockIndex);
+
+		for (const int32 blockIndex : Members)
+			if (!Next.Contains(blockIndex))
+				OutRemoved.Add(blockIndex);
+	}
+
+private:
+	TBitArray<> Bits;
+	TArray<int32> Members;
+	TArray<int32> Positions;
+};
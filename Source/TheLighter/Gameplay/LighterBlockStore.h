@@ -0,0 +1,172 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Packed per-block state of every LighterBlock, keyed by its LighterBlockSubsystem index
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+* Bulk passes (Resolve, Tracer narrow phase, debug tooling) used to read the block state off the actors
+* That's one UObject pointer chase per block, per pass
+*
+* Instead, the state lives here as a STRUCTURE OF ARRAYS, all indexed by BlockIndex
+*
+* 		BoundsMin / BoundsMax	=> YZ bounds								(8 + 8 bytes)
+* 		Valid					=> Slot is in use							(1 bit)
+* 		Solid					=> Response the body has right now			(1 bit)
+* 		TargetSolid				=> Response the emitters want				(1 bit)
+* 		Dirty					=> On the subsystem's dirty list			(1 bit)
+* 		Parked					=> A ball was inside when we tried to apply	(1 bit)
+* 		LitCounts				=> Emitters currently lighting the block	(2 bytes)
+* 		Fades					=> Last lit fade written to the block		(16 bytes, See LighterLitVisuals.h)
+*
+* A pass only pulls in the arrays it reads, and walks them front to back
+* The actors only get touched when a block's physics body actually has to change
+*
+* NOTE: Solid => ECR_Block, otherwise ECR_Overlap (The only two states a LighterBlock has)
+*/
+
+class FLighterBlockStore
+{
+public:
+	// Grow to cover BlockIndex & start it off as an unlit PassThrough block
+	void Reset(const int32 BlockIndex, const FBox2D& Bounds)
+	{
+		check(BlockIndex >= 0);
+		if (BlockIndex >= Num())
+		{
+			const int32 num = BlockIndex + 1;
+			BoundsMin.SetNumZeroed(num);
+			BoundsMax.SetNumZeroed(num);
+			LitCounts.SetNumZeroed(num);
+			Fades.SetNumZeroed(num);
+			Valid.Add(false, num - Valid.Num());
+			Solid.Add(false, num - Solid.Num());
+			TargetSolid.Add(false, num - TargetSolid.Num());
+			Dirty.Add(false, num - Dirty.Num());
+			Parked.Add(false, num - Parked.Num());
+		}
+
+		BoundsMin[BlockIndex] = Bounds.Min;
+		BoundsMax[BlockIndex] = Bounds.Max;
+		LitCounts[BlockIndex] = 0;
+		Fades[BlockIndex] = FVector4(0.f, 0.f, 0.f, 0.f);
+		Valid[BlockIndex] = true;
+		Solid[BlockIndex] = false;
+		TargetSolid[BlockIndex] = false;
+		Dirty[BlockIndex] = false;
+		Parked[BlockIndex] = false;
+	}
+
+	// Slot stays allocated, it's just not a block anymore
+	void Clear(const int32 BlockIndex)
+	{
+		if (!IsValid(BlockIndex)) return;
+
+		Valid[BlockIndex] = false;
+		LitCounts[BlockIndex] = 0;
+		Solid[BlockIndex] = false;
+		TargetSolid[BlockIndex] = false;
+		Dirty[BlockIndex] = false;
+		Parked[BlockIndex] = false;
+	}
+
+	FORCEINLINE int32 Num() const { return BoundsMin.Num(); }
+	FORCEINLINE bool IsValid(const int32 BlockIndex) const { return BlockIndex >= 0 && BlockIndex < Valid.Num() && Valid[BlockIndex]; }
+
+
+	// BOUNDS
+	FORCEINLINE FBox2D GetBounds(const int32 BlockIndex) const { return FBox2D(BoundsMin[BlockIndex], BoundsMax[BlockIndex]); }
+	FORCEINLINE void SetBounds(const int32 BlockIndex, const FBox2D& Bounds) { BoundsMin[BlockIndex] = Bounds.Min; BoundsMax[BlockIndex] = Bounds.Max; }
+	FORCEINLINE bool Intersects(const int32 BlockIndex, const FBox2D& Box) const
+	{
+		const FVector2D& min = BoundsMin[BlockIndex];
+		const FVector2D& max = BoundsMax[BlockIndex];
+		return min.X <= Box.Max.X && max.X >= Box.Min.X && min.Y <= Box.Max.Y && max.Y >= Box.Min.Y;
+	}
+	FORCEINLINE const TArray<FVector2D>& GetBoundsMin() const { return BoundsMin; }
+	FORCEINLINE const TArray<FVector2D>& GetBoundsMax() const { return BoundsMax; }
+
+
+	// RESPONSE BITS
+	FORCEINLINE bool IsSolid(const int32 BlockIndex) const { return Solid[BlockIndex]; }
+	FORCEINLINE bool IsTargetSolid(const int32 BlockIndex) const { return TargetSolid[BlockIndex]; }
+	FORCEINLINE bool HasPendingChange(const int32 BlockIndex) const { return (bool)Solid[BlockIndex] != (bool)TargetSolid[BlockIndex]; }
+	FORCEINLINE void SetSolid(const int32 BlockIndex, const bool bSolid) { Solid[BlockIndex] = bSolid; }
+
+	// Returns false if it already was
+	FORCEINLINE bool SetTargetSolid(const int32 BlockIndex, const bool bSolid)
+	{
+		if (TargetSolid[BlockIndex] == bSolid) return false;
+		TargetSolid[BlockIndex] = bSolid;
+		return true;
+	}
+
+	FORCEINLINE bool IsDirty(const int32 BlockIndex) const { return Dirty[BlockIndex]; }
+	FORCEINLINE void SetDirty(const int32 BlockIndex, const bool bDirty) { Dirty[BlockIndex] = bDirty; }
+
+	FORCEINLINE bool IsParked(const int32 BlockIndex) const { return Parked[BlockIndex]; }
+	FORCEINLINE void SetParked(const int32 BlockIndex, const bool bParked) { Parked[BlockIndex] = bParked; }
+
+
+	// LIT COUNTS
+	FORCEINLINE uint16 GetLitCount(const int32 BlockIndex) const { return LitCounts[BlockIndex]; }
+
+	// True on 0 => 1 (Block just got lit)
+	FORCEINLINE bool AddLight(const int32 BlockIndex) { return LitCounts[BlockIndex]++ == 0; }
+
+	// True on 1 => 0 (Block just went dark)
+	FORCEINLINE bool RemoveLight(const int32 BlockIndex) { return LitCounts[BlockIndex] > 0 && --LitCounts[BlockIndex] == 0; }
+
+
+	// LIT FADES
+	FORCEINLINE const FVector4& GetFade(const int32 BlockIndex) const { return Fades[BlockIndex]; }
+	FORCEINLINE void SetFade(const int32 BlockIndex, const FVector4& Fade) { Fades[BlockIndex] = Fade; }
+
+
+	// CHECKPOINTS
+	// Whole bit arrays, copied word by word (See LighterCheckpoint.h)
+	FORCEINLINE const TBitArray<>& GetValidBits() const { return Valid; }
+	FORCEINLINE const TBitArray<>& GetSolidBits() const { return Solid; }
+	FORCEINLINE const TBitArray<>& GetTargetSolidBits() const { return TargetSolid; }
+
+
+	// One linear pass per array => Totals for the debug tooling
+	struct FSummary
+	{
+		int32 NumBlocks = 0;
+		int32 NumSolid = 0;
+		int32 NumPending = 0;
+		int32 NumParked = 0;
+		int32 NumLit = 0;
+	};
+
+	FSummary Summarize() const
+	{
+		FSummary summary;
+		for (TConstSetBitIterator<> it(Valid); it; ++it)
+		{
+			const int32 blockIndex = it.GetIndex();
+			++summary.NumBlocks;
+			summary.NumSolid += Solid[blockIndex] ? 1 : 0;
+			summary.NumPending += HasPendingChange(blockIndex) ? 1 : 0;
+			summary.NumParked += Parked[blockIndex] ? 1 : 0;
+		}
+		for (const uint16 litCount : LitCounts)
+			summary.NumLit += litCount > 0 ? 1 : 0;
+		return summary;
+	}
+
+private:
+	TArray<FVector2D> BoundsMin;
+	TArray<FVector2D> BoundsMax;
+	TArray<uint16> LitCounts;
+	TArray<FVector4> Fades;
+
+	TBitArray<> Valid;
+	TBitArray<> Solid;
+	TBitArray<> TargetSolid;
+	TBitArray<> Dirty;
+	TBitArray<> Parked;
+};
@@ -0,0 +1,1196 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Central manager for every LighterBlock in the world
+
+#include "LighterBlockSubsystem.h"
+#include "TheLighter.h"
+#include "Block.h"
+#include "BlockField.h"
+#include "TheLighterBall.h"
+#include "LighterCollision.h"
+#include "LighterLitVisuals.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+
+static TAutoConsoleVariable<int32> CVarLighterStreaming(
+	TEXT("Lighter.Streaming"),
+	1,
+	TEXT("1 => Only the LighterBlock chunks around the PlayerBall are awake\n")
+	TEXT("0 => Every LighterBlock stays awake"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLighterStreamingRadius(
+	TEXT("Lighter.Streaming.Radius"),
+	6000.f,
+	TEXT("Distance along Y, on each side of the PlayerBall, that's kept awake"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLighterStreamingLeadSeconds(
+	TEXT("Lighter.Streaming.LeadSeconds"),
+	1.5f,
+	TEXT("Seconds of PlayerBall velocity the awake window gets pushed ahead by"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLighterStreamingBudgetMs(
+	TEXT("Lighter.Streaming.BudgetMs"),
+	0.5f,
+	TEXT("Game thread milliseconds per frame for waking & sleeping LighterBlocks"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLighterPrelight(
+	TEXT("Lighter.Prelight"),
+	1,
+	TEXT("1 => Blocks the balls' cones are about to reach get staged & turn solid the moment they're lit\n")
+	TEXT("0 => Every collision change waits for the dirty list (After physics)"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLighterPrelightFrames(
+	TEXT("Lighter.Prelight.Frames"),
+	3,
+	TEXT("Frames ahead the balls project their tracer & trajectory to stage blocks"),
+	ECVF_Default);
+
+
+
+////////////////////////////////////////////////////////////////////// REGISTRY
+#pragma region REGISTRY
+int32 ULighterBlockSubsystem::AllocateIndex()
+{
+	if (FreeIndices.Num() > 0)
+		return FreeIndices.Pop(false);
+
+	return Slots.AddDefaulted();
+}
+
+void ULighterBlockSubsystem::ForgetBlock(const int32 BlockIndex)
+{
+	if (Store.IsDirty(BlockIndex))
+		DirtyBlocks.RemoveSingleSwap(BlockIndex, false);
+
+	// Nobody gets to keep lighting a block that's gone (Or asleep)
+	if (Store.GetLitCount(BlockIndex) > 0)
+		--NumLitBlocks;
+	for (FLighterEmitter& emitter : Emitters)
+		emitter.LitSet.Remove(BlockIndex);
+
+	StagedBlocks.Remove(BlockIndex);
+	if (LitStamps.IsValidIndex(BlockIndex))
+		LitStamps[BlockIndex] = FLitStamp();
+
+	Grid.Remove(BlockIndex, Store.GetBounds(BlockIndex));
+	InvalidateEmitters(Store.GetBounds(BlockIndex));
+}
+
+void ULighterBlockSubsystem::FreeIndex(const int32 BlockIndex)
+{
+	ForgetBlock(BlockIndex);
+	Store.Clear(BlockIndex);
+	Slots[BlockIndex] = FLighterBlockSlot();
+	FreeIndices.Add(BlockIndex);
+	++RegistryVersion;
+}
+
+void ULighterBlockSubsystem::RegisterBlock(ABlock* Block)
+{
+	LIGHTER_LLM_SCOPE();
+	if (!Block || Block->BlockIndex != INDEX_NONE) return;
+
+	const FBox2D bounds = Block->GetBounds2D();
+	Block->BlockIndex = AllocateIndex();
+	Slots[Block->BlockIndex].Block = Block;
+	Store.Reset(Block->BlockIndex, bounds);
+	Grid.Add(Block->BlockIndex, bounds);
+	InvalidateEmitters(bounds);
+	++RegistryVersion;
+}
+
+void ULighterBlockSubsystem::UnregisterBlock(ABlock* Block)
+{
+	if (!Block || !Slots.IsValidIndex(Block->BlockIndex) || Slots[Block->BlockIndex].Block != Block) return;
+
+	FreeIndex(Block->BlockIndex);
+	Block->BlockIndex = INDEX_NONE;
+}
+
+void ULighterBlockSubsystem::ShiftBlock(ABlock* Block, const FVector& Offset)
+{
+	if (!Block || !Store.IsValid(Block->BlockIndex)) return;
+	const int32 blockIndex = Block->BlockIndex;
+
+	// DORMANT blocks aren't in the grid (Or in any cone) to begin with
+	const int32 unitId = Block->StreamingUnit;
+	const bool bDormant = StreamingUnits.IsValidIndex(unitId) && StreamingUnits[unitId].bDormant;
+
+	const FBox2D oldBounds = Store.GetBounds(blockIndex);
+	const FVector2D planeOffset = ToLighterPlane(Offset);
+	const FBox2D newBounds(oldBounds.Min + planeOffset, oldBounds.Max + planeOffset);
+	if (!bDormant)
+	{
+		Grid.Remove(blockIndex, oldBounds);
+		InvalidateEmitters(oldBounds);
+	}
+
+	Store.SetBounds(blockIndex, newBounds);
+
+	if (!bDormant)
+	{
+		Grid.Add(blockIndex, newBounds);
+		InvalidateEmitters(newBounds);
+	}
+
+	if (StreamingUnits.IsValidIndex(unitId) && StreamingUnits[unitId].IsValid())
+	{
+		RemoveUnitFromChunks(unitId);
+		AddUnitToChunks(unitId, newBounds);
+		if (bHasStreamingWindow)
+			QueueStreamingUnit(unitId);
+	}
+}
+
+int32 ULighterBlockSubsystem::RegisterInstance(ABlockField* Field, const int32 InstanceIndex, const FBox2D& Bounds)
+{
+	LIGHTER_LLM_SCOPE();
+	if (!Field) return INDEX_NONE;
+
+	const int32 blockIndex = AllocateIndex();
+	Slots[blockIndex].Field = Field;
+	Slots[blockIndex].InstanceIndex = InstanceIndex;
+	Store.Reset(blockIndex, Bounds);
+	Grid.Add(blockIndex, Bounds);
+	InvalidateEmitters(Bounds);
+	++RegistryVersion;
+	return blockIndex;
+}
+
+void ULighterBlockSubsystem::UnregisterInstance(const int32 BlockIndex)
+{
+	if (!Slots.IsValidIndex(BlockIndex) || !Slots[BlockIndex].Field) return;
+
+	FreeIndex(BlockIndex);
+}
+
+int32 ULighterBlockSubsystem::GetBlockIndexFromHit(const FHitResult& Hit) const
+{
+	AActor* hitActor = Hit.GetActor();
+
+	if (const ABlock* block = Cast<ABlock>(hitActor))
+		return block->BlockIndex;
+
+	// Instanced hits carry the instance in Item
+	if (const ABlockField* field = Cast<ABlockField>(hitActor))
+		return field->GetBlockIndex(Hit.Item);
+
+	return INDEX_NONE;
+}
+#pragma endregion REGISTRY
+////////////////////////////////////////////////////////////////////// REGISTRY
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// COLLISION
+#pragma region COLLISION
+void ULighterBlockSubsystem::SetTargetCollisionResponse(const int32 BlockIndex, const ECollisionResponse CollisionResponse)
+{
+	if (!Store.IsValid(BlockIndex)) return;
+
+	// Only the bits (And the fade) change here, the physics body isn't touched until it's resolved
+	const bool bLit = CollisionResponse == ECR_Block;
+	if (Store.SetTargetSolid(BlockIndex, bLit))
+	{
+		MarkDirty(BlockIndex);
+		WriteLitVisual(BlockIndex, bLit);
+	}
+}
+
+// The fade starts NOW, from wherever the last one had got to
+// Goes into the block's custom data once, the material runs it from there
+
+void ULighterBlockSubsystem::WriteLitVisual(const int32 BlockIndex, const bool bLit)
+{
+	const float time = GetWorld()->GetTimeSeconds();
+	const FVector4 fade(LighterLitVisuals::Evaluate(Store.GetFade(BlockIndex), time), bLit ? 1.f : 0.f, time, LighterLitVisuals::GetFadeSeconds());
+	Store.SetFade(BlockIndex, fade);
+
+	const FLighterBlockSlot& slot = Slots[BlockIndex];
+	if (slot.Block)
+		slot.Block->SetLitVisual(fade);
+	else if (slot.Field)
+	{
+		slot.Field->SetInstanceLitVisual(slot.InstanceIndex, fade);
+		LitVisualFields.AddUnique(slot.Field);
+	}
+}
+
+void ULighterBlockSubsystem::FlushLitVisuals()
+{
+	for (ABlockField* field : LitVisualFields)
+		if (field)
+			field->FlushLitVisuals();
+	LitVisualFields.Reset();
+}
+
+void ULighterBlockSubsystem::OnBallEndOverlap(const int32 BlockIndex)
+{
+	if (!Store.IsValid(BlockIndex)) return;
+
+	Store.SetParked(BlockIndex, false);
+	if (Store.HasPendingChange(BlockIndex))
+		MarkDirty(BlockIndex);
+}
+
+bool ULighterBlockSubsystem::IsOverlappedByBall(const FLighterBlockSlot& Slot) const
+{
+	for (const ATheLighterBall* ball : Balls)
+	{
+		if (Slot.Block ? Slot.Block->IsOverlappedByBall(ball) : Slot.Field->IsInstanceOverlappedByBall(Slot.InstanceIndex, ball))
+			return true;
+	}
+	return false;
+}
+
+// The physics body itself => Only ever from the resolve (Or a checkpoint restore)
+
+void ULighterBlockSubsystem::ApplyCollision(const int32 BlockIndex, const bool bSolid)
+{
+	const FLighterBlockSlot& slot = Slots[BlockIndex];
+	if (slot.Block)
+		slot.Block->SetCollisionMode(bSolid ? ECR_Block : ECR_Overlap);
+	else
+		slot.Field->SetInstanceCollisionMode(slot.InstanceIndex, bSolid ? ECR_Block : ECR_Overlap);
+
+	Store.SetSolid(BlockIndex, bSolid);
+
+	// Lit => Solid, the next physics step is the first one to see it
+	if (bSolid && LitStamps.IsValidIndex(BlockIndex) && LitStamps[BlockIndex].Time > 0.0)
+	{
+		AwaitingPhysics.Add(LitStamps[BlockIndex]);
+		LitStamps[BlockIndex].Time = 0.0;
+	}
+}
+
+void ULighterBlockSubsystem::RegisterBall(ATheLighterBall* Ball)
+{
+	if (Ball)
+		Balls.AddUnique(Ball);
+}
+
+void ULighterBlockSubsystem::UnregisterBall(ATheLighterBall* Ball)
+{
+	Balls.RemoveSingleSwap(Ball, false);
+}
+#pragma endregion COLLISION
+////////////////////////////////////////////////////////////////////// COLLISION
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// DIRTY LIST
+#pragma region DIRTY LIST
+void ULighterBlockSubsystem::MarkDirty(const int32 BlockIndex)
+{
+	if (!Store.IsValid(BlockIndex) || Store.IsDirty(BlockIndex)) return;
+
+	Store.SetDirty(BlockIndex, true);
+	DirtyBlocks.Add(BlockIndex);
+}
+
+void ULighterBlockSubsystem::ResolveDirtyBlocks()
+{
+	if (DirtyBlocks.Num() == 0) return;
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterResolveDirtyBlocks);
+
+	// 1. Bits only => Drop every block that went back to what it already is (Lit & unlit before we got to it)
+	// No actor gets touched for those
+	int32 numPending = 0;
+	for (const int32 blockIndex : DirtyBlocks)
+	{
+		Store.SetDirty(blockIndex, false);
+		if (Store.HasPendingChange(blockIndex))
+			DirtyBlocks[numPending++] = blockIndex;
+	}
+	DirtyBlocks.SetNum(numPending, false);
+	if (numPending == 0) return;
+
+	// 2. Every block left really changes
+	ResolveBlocks(DirtyBlocks);
+	DirtyBlocks.Reset();
+}
+
+// Resolved => Done
+// Blocked by ANY ball => PARKED until that ball's EndOverlap marks it dirty again
+
+void ULighterBlockSubsystem::ResolveBlocks(const TArray<int32>& BlockIndices)
+{
+	auto resolveAll = [this, &BlockIndices]()
+	{
+		for (const int32 blockIndex : BlockIndices)
+		{
+			const FLighterBlockSlot& slot = Slots[blockIndex];
+			{
+				LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterBlockResolveCollision);
+				if (IsOverlappedByBall(slot))
+				{
+					Store.SetParked(blockIndex, true);
+					continue;
+				}
+			}
+
+			ApplyCollision(blockIndex, Store.IsTargetSolid(blockIndex));
+			Store.SetParked(blockIndex, false);
+		}
+	};
+
+	// Fast path => Every filter flip of the frame goes through under ONE scene write lock
+	// (Instead of each body taking & releasing it on its own)
+	FPhysScene* physScene = GetWorld()->GetPhysicsScene();
+	if (physScene && LighterCollision::UseFastToggle())
+		FPhysicsCommand::ExecuteWrite(physScene, resolveAll);
+	else
+		resolveAll();
+}
+#pragma endregion DIRTY LIST
+////////////////////////////////////////////////////////////////////// DIRTY LIST
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// CHECKPOINTS
+#pragma region CHECKPOINTS
+void ULighterBlockSubsystem::CaptureCheckpoint(FLighterCheckpoint& OutCheckpoint) const
+{
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterCaptureCheckpoint);
+	LIGHTER_LLM_SCOPE();
+
+	OutCheckpoint.bValid = true;
+	OutCheckpoint.Time = GetWorld()->GetTimeSeconds();
+	CaptureBlocks(OutCheckpoint.Blocks);
+
+	OutCheckpoint.Balls.SetNum(Balls.Num());
+	for (int32 i = 0; i < Balls.Num(); ++i)
+		if (Balls[i])
+			Balls[i]->CaptureSnapshot(OutCheckpoint.Balls[i]);
+}
+
+void ULighterBlockSubsystem::RestoreCheckpoint(const FLighterCheckpoint& InCheckpoint)
+{
+	if (!InCheckpoint.bValid) return;
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterRestoreCheckpoint);
+	LIGHTER_LLM_SCOPE();
+
+	// Balls first, so the resolve sees them where they were
+	// Matched by actor, or by order for a checkpoint that was loaded off disk
+	for (int32 i = 0; i < InCheckpoint.Balls.Num(); ++i)
+	{
+		const FLighterBallSnapshot& snapshot = InCheckpoint.Balls[i];
+		ATheLighterBall* ball = snapshot.Ball.IsValid() ? snapshot.Ball.Get() : (Balls.IsValidIndex(i) ? Balls[i] : nullptr);
+		if (ball)
+			ball->RestoreSnapshot(snapshot);
+	}
+
+	RestoreBlocks(InCheckpoint.Blocks);
+}
+
+bool ULighterBlockSubsystem::LoadCheckpoint()
+{
+	if (!Checkpoint.bValid) return false;
+	RestoreCheckpoint(Checkpoint);
+	return true;
+}
+
+void ULighterBlockSubsystem::CaptureBlocks(FLighterBlockSnapshot& OutSnapshot) const
+{
+	OutSnapshot.Valid = Store.GetValidBits();
+	OutSnapshot.Solid = Store.GetSolidBits();
+	OutSnapshot.TargetSolid = Store.GetTargetSolidBits();
+
+	// Lit counts are just the sum of these
+	OutSnapshot.EmitterLitSets.SetNum(Emitters.Num());
+	for (int32 emitterId = 0; emitterId < Emitters.Num(); ++emitterId)
+	{
+		if (Emitters[emitterId].bRegistered)
+			OutSnapshot.EmitterLitSets[emitterId] = Emitters[emitterId].LitSet.GetMembers();
+		else
+			OutSnapshot.EmitterLitSets[emitterId].Reset();
+	}
+}
+
+/*
+* 1. LIT STATE	=> Every emitter goes back to its LITSET through the usual diff
+* 				   So lit counts, targets & fades only change for the blocks that differ
+* 2. RESPONSES	=> Blocks whose body isn't what it was get it applied right away, under ONE scene lock
+* 				   The ball's back where it was, so that's exactly the state it was in
+* 3. Whatever was still pending goes on the dirty list (Parked again if a ball's inside)
+*
+* NOTE: Blocks registered after the capture are left alone
+*/
+
+void ULighterBlockSubsystem::RestoreBlocks(const FLighterBlockSnapshot& Snapshot)
+{
+	// 1.
+	for (int32 emitterId = 0; emitterId < Emitters.Num(); ++emitterId)
+	{
+		FLighterEmitter& emitter = Emitters[emitterId];
+		if (!emitter.bRegistered) continue;
+
+		EmitterHits.Reset();
+		if (Snapshot.EmitterLitSets.IsValidIndex(emitterId))
+			for (const int32 blockIndex : Snapshot.EmitterLitSets[emitterId])
+				if (Store.IsValid(blockIndex))
+					EmitterHits.Add(blockIndex);
+
+		ApplyEmitterHits(emitter, EmitterHits);
+
+		// A cone emitter checks its restored set against its cone once more
+		emitter.bConeChanged = emitter.bHasCone;
+	}
+
+	// 2.
+	const int32 num = FMath::Min(Store.Num(), Snapshot.Valid.Num());
+	RestoreScratch.Reset();
+	for (int32 blockIndex = 0; blockIndex < num; ++blockIndex)
+	{
+		if (!Snapshot.Valid[blockIndex] || !Store.IsValid(blockIndex)) continue;
+
+		SetTargetCollisionResponse(blockIndex, Snapshot.TargetSolid[blockIndex] ? ECR_Block : ECR_Overlap);
+		Store.SetParked(blockIndex, false);
+		if (Store.IsSolid(blockIndex) != (bool)Snapshot.Solid[blockIndex])
+			RestoreScratch.Add(blockIndex);
+	}
+
+	auto applyAll = [this, &Snapshot]()
+	{
+		for (const int32 blockIndex : RestoreScratch)
+			ApplyCollision(blockIndex, Snapshot.Solid[blockIndex]);
+	};
+
+	FPhysScene* physScene = GetWorld()->GetPhysicsScene();
+	if (RestoreScratch.Num() > 0 && physScene && LighterCollision::UseFastToggle())
+		FPhysicsCommand::ExecuteWrite(physScene, applyAll);
+	else
+		applyAll();
+
+	// 3. The dirty list may hold blocks that are settled now, the resolve drops those
+	for (int32 blockIndex = 0; blockIndex < num; ++blockIndex)
+		if (Store.IsValid(blockIndex) && Store.HasPendingChange(blockIndex))
+			MarkDirty(blockIndex);
+
+	// Predictions from before the restore don't mean anything after it
+	StagedBlocks.Reset();
+	CommitQueue.Reset();
+}
+#pragma endregion CHECKPOINTS
+////////////////////////////////////////////////////////////////////// CHECKPOINTS
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// SPATIAL QUERIES
+#pragma region SPATIAL QUERIES
+void ULighterBlockSubsystem::QueryCone(const FLighterCone& Cone, TArray<int32>& OutBlockIndices) const
+{
+	Grid.QueryCone(Cone, Store, OutBlockIndices);
+}
+#pragma endregion SPATIAL QUERIES
+////////////////////////////////////////////////////////////////////// SPATIAL QUERIES
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// STREAMING
+#pragma region STREAMING
+int32 ULighterBlockSubsystem::RegisterStreamingUnit(ABlock* Block, ABlockField* Field, const FBox2D& Bounds)
+{
+	LIGHTER_LLM_SCOPE();
+	if ((!Block && !Field) || !Bounds.bIsValid) return INDEX_NONE;
+
+	const int32 unitId = FreeStreamingUnits.Num() > 0 ? FreeStreamingUnits.Pop(false) : StreamingUnits.AddDefaulted();
+	FLighterStreamingUnit& unit = StreamingUnits[unitId];
+	unit.Block = Block;
+	unit.Field = Field;
+	AddUnitToChunks(unitId, Bounds);
+
+	// Everything starts AWAKE, the queue decides if it should sleep
+	++NumAwakeUnits;
+	if (bHasStreamingWindow)
+		QueueStreamingUnit(unitId);
+
+	return unitId;
+}
+
+void ULighterBlockSubsystem::UnregisterStreamingUnit(const int32 UnitId)
+{
+	if (!StreamingUnits.IsValidIndex(UnitId) || !StreamingUnits[UnitId].IsValid()) return;
+	FLighterStreamingUnit& unit = StreamingUnits[UnitId];
+	RemoveUnitFromChunks(UnitId);
+
+	// Keep the queue's nearest-first order
+	if (unit.bQueued)
+		StreamingQueue.RemoveSingle(UnitId);
+	if (!unit.bDormant)
+		--NumAwakeUnits;
+
+	unit = FLighterStreamingUnit();
+	FreeStreamingUnits.Add(UnitId);
+}
+
+void ULighterBlockSubsystem::AddUnitToChunks(const int32 UnitId, const FBox2D& Bounds)
+{
+	FLighterStreamingUnit& unit = StreamingUnits[UnitId];
+	unit.MinChunk = GetChunk(Bounds.Min.X);
+	unit.MaxChunk = GetChunk(Bounds.Max.X);
+
+	for (int32 chunk = unit.MinChunk; chunk <= unit.MaxChunk; ++chunk)
+		Chunks.FindOrAdd(chunk).Add(UnitId);
+}
+
+void ULighterBlockSubsystem::RemoveUnitFromChunks(const int32 UnitId)
+{
+	const FLighterStreamingUnit& unit = StreamingUnits[UnitId];
+
+	for (int32 chunk = unit.MinChunk; chunk <= unit.MaxChunk; ++chunk)
+		if (TArray<int32>* chunkUnits = Chunks.Find(chunk))
+		{
+			chunkUnits->RemoveSingleSwap(UnitId, false);
+			if (chunkUnits->Num() == 0)
+				Chunks.Remove(chunk);
+		}
+}
+
+void ULighterBlockSubsystem::QueueStreamingUnit(const int32 UnitId)
+{
+	FLighterStreamingUnit& unit = StreamingUnits[UnitId];
+	if (unit.bQueued) return;
+
+	unit.bQueued = true;
+	StreamingQueue.Add(UnitId);
+}
+
+template <typename FuncType>
+void ULighterBlockSubsystem::ForEachUnitBlock(const FLighterStreamingUnit& Unit, FuncType Func) const
+{
+	if (Unit.Block)
+	{
+		if (Store.IsValid(Unit.Block->BlockIndex))
+			Func(Unit.Block->BlockIndex);
+	}
+	else if (Unit.Field)
+	{
+		for (const int32 blockIndex : Unit.Field->GetBlockIndices())
+			if (Store.IsValid(blockIndex))
+				Func(blockIndex);
+	}
+}
+
+void ULighterBlockSubsystem::SetUnitDormant(FLighterStreamingUnit& Unit, const bool bDormant)
+{
+	if (Unit.bDormant == bDormant) return;
+	Unit.bDormant = bDormant;
+	NumAwakeUnits += bDormant ? -1 : 1;
+
+	// Sleep => Out of the emitters & the grid first, then the actor lets go of its bodies & render state
+	// Wake  => Actor first, so the block is back in the world before a cone can light it again
+	if (bDormant)
+		ForEachUnitBlock(Unit, [this](const int32 BlockIndex) { SetBlockDormant(BlockIndex, true); });
+
+	if (Unit.Block)
+		Unit.Block->SetDormant(bDormant);
+	else if (Unit.Field)
+		Unit.Field->SetDormant(bDormant);
+
+	if (!bDormant)
+		ForEachUnitBlock(Unit, [this](const int32 BlockIndex) { SetBlockDormant(BlockIndex, false); });
+}
+
+/*
+* A DORMANT block keeps its BlockIndex (Checkpoints & the replicator's net order stay put)
+* Everything else goes => Lit state, dirty / parked flags & its grid cells
+* So no cone can light it, and it wakes up as a fresh unlit PassThrough block
+*/
+
+void ULighterBlockSubsystem::SetBlockDormant(const int32 BlockIndex, const bool bDormant)
+{
+	if (bDormant)
+	{
+		ForgetBlock(BlockIndex);
+		Store.Reset(BlockIndex, Store.GetBounds(BlockIndex));
+		return;
+	}
+
+	Grid.Add(BlockIndex, Store.GetBounds(BlockIndex));
+
+	// Cached cones never saw it
+	InvalidateEmitters(Store.GetBounds(BlockIndex));
+}
+
+
+
+/*
+* 1. Window	=> Chunks within Radius of the PlayerBall, stretched by Velocity.Y * LeadSeconds on the side it's heading to
+* 2. Window moved => Queue the units on the chunks that entered / left it (Nearest first)
+* 3. Work off the queue until the frame's budget runs out
+*
+* NOTE: Units only go DORMANT one chunk past the window edge
+* 		So a ball jittering on a chunk boundary doesn't keep waking & sleeping the same blocks
+*/
+
+void ULighterBlockSubsystem::UpdateStreaming()
+{
+	if (StreamingUnits.Num() == FreeStreamingUnits.Num()) return;
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterUpdateStreaming);
+
+	auto queueChunks = [this](const int32 FromChunk, const int32 ToChunk)
+	{
+		for (int32 chunk = FromChunk; chunk <= ToChunk; ++chunk)
+			if (const TArray<int32>* chunkUnits = Chunks.Find(chunk))
+				for (const int32 unitId : *chunkUnits)
+					QueueStreamingUnit(unitId);
+	};
+
+	auto queueAll = [this]()
+	{
+		for (int32 unitId = 0; unitId < StreamingUnits.Num(); ++unitId)
+			if (StreamingUnits[unitId].IsValid())
+				QueueStreamingUnit(unitId);
+	};
+
+	if (CVarLighterStreaming.GetValueOnGameThread() == 0)
+	{
+		// Streaming turned off => Wake everything back up
+		if (bHasStreamingWindow)
+		{
+			bHasStreamingWindow = false;
+			queueAll();
+		}
+	}
+	else if (Balls.Num() > 0)
+	{
+		// 1. Window (Spans every ball, so co-op players never run into sleeping blocks)
+		const float radius = CVarLighterStreamingRadius.GetValueOnGameThread();
+		const float leadSeconds = CVarLighterStreamingLeadSeconds.GetValueOnGameThread();
+
+		TArray<int32, TInlineAllocator<4>> ballChunks;
+		int32 minChunk = MAX_int32;
+		int32 maxChunk = MIN_int32;
+		for (const ATheLighterBall* ball : Balls)
+		{
+			const float y = ball->GetActorLocation().Y;
+			const float lead = ball->GetVelocity().Y * leadSeconds;
+			minChunk = FMath::Min(minChunk, GetChunk(y - radius + FMath::Min(0.f, lead)));
+			maxChunk = FMath::Max(maxChunk, GetChunk(y + radius + FMath::Max(0.f, lead)));
+			ballChunks.Add(GetChunk(y));
+		}
+
+		// 2. Queue whatever might have changed
+		if (!bHasStreamingWindow || maxChunk - minChunk > Chunks.Num() || WindowMaxChunk - WindowMinChunk > Chunks.Num())
+			queueAll();
+		else if (minChunk != WindowMinChunk || maxChunk != WindowMaxChunk)
+		{
+			// Entered the window => Might wake
+			queueChunks(minChunk, FMath::Min(maxChunk, WindowMinChunk - 1));
+			queueChunks(FMath::Max(minChunk, WindowMaxChunk + 1), maxChunk);
+
+			// Left the window (+1 chunk) => Might sleep
+			queueChunks(WindowMinChunk - 1, FMath::Min(WindowMaxChunk + 1, minChunk - 2));
+			queueChunks(FMath::Max(WindowMinChunk - 1, maxChunk + 2), WindowMaxChunk + 1);
+		}
+
+		if (!bHasStreamingWindow || minChunk != WindowMinChunk || maxChunk != WindowMaxChunk)
+		{
+			bHasStreamingWindow = true;
+			WindowMinChunk = minChunk;
+			WindowMaxChunk = maxChunk;
+
+			// Nearest (To any ball) first
+			auto distanceToBalls = [this, &ballChunks](const int32 UnitId)
+			{
+				const FLighterStreamingUnit& unit = StreamingUnits[UnitId];
+				int32 distance = MAX_int32;
+				for (const int32 ballChunk : ballChunks)
+					distance = FMath::Min(distance, FMath::Max3(0, unit.MinChunk - ballChunk, ballChunk - unit.MaxChunk));
+				return distance;
+			};
+			StreamingQueue.Sort([&distanceToBalls](const int32 A, const int32 B) { return distanceToBalls(A) < distanceToBalls(B); });
+		}
+	}
+
+	// 3. Time-sliced wake / sleep
+	const double budgetSeconds = CVarLighterStreamingBudgetMs.GetValueOnGameThread() / 1000.0;
+	const double startTime = FPlatformTime::Seconds();
+	int32 numProcessed = 0;
+	int32 numChanged = 0;
+
+	while (numProcessed < StreamingQueue.Num())
+	{
+		FLighterStreamingUnit& unit = StreamingUnits[StreamingQueue[numProcessed++]];
+		unit.bQueued = false;
+
+		const bool bWantsAwake = !bHasStreamingWindow || unit.Overlaps(WindowMinChunk, WindowMaxChunk);
+		const bool bWantsDormant = bHasStreamingWindow && !unit.Overlaps(WindowMinChunk - 1, WindowMaxChunk + 1);
+		if ((bWantsAwake && unit.bDormant) || (bWantsDormant && !unit.bDormant))
+		{
+			SetUnitDormant(unit, bWantsDormant);
+			++numChanged;
+
+			if (FPlatformTime::Seconds() - startTime > budgetSeconds)
+				break;
+		}
+	}
+	StreamingQueue.RemoveAt(0, numProcessed, false);
+
+	LIGHTER_INC_COUNTER(STAT_LighterStreamingOps, numChanged);
+	LIGHTER_INC_COUNTER(STAT_LighterAwakeUnits, NumAwakeUnits);
+}
+#pragma endregion STREAMING
+////////////////////////////////////////////////////////////////////// STREAMING
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// EMITTERS
+#pragma region EMITTERS
+int32 ULighterBlockSubsystem::RegisterEmitter()
+{
+	LIGHTER_LLM_SCOPE();
+	const int32 emitterId = FreeEmitters.Num() > 0 ? FreeEmitters.Pop(false) : Emitters.AddDefaulted();
+	Emitters[emitterId] = FLighterEmitter();
+	Emitters[emitterId].bRegistered = true;
+	return emitterId;
+}
+
+void ULighterBlockSubsystem::UnregisterEmitter(const int32 EmitterId)
+{
+	if (!Emitters.IsValidIndex(EmitterId) || !Emitters[EmitterId].bRegistered) return;
+
+	ClearEmitter(EmitterId);
+	Emitters[EmitterId].bRegistered = false;
+	FreeEmitters.Add(EmitterId);
+}
+
+void ULighterBlockSubsystem::SetEmitterCone(const int32 EmitterId, const FLighterCone& Cone, const ELighterEmitterQuery Query)
+{
+	if (!Emitters.IsValidIndex(EmitterId) || !Emitters[EmitterId].bRegistered) return;
+	FLighterEmitter& emitter = Emitters[EmitterId];
+
+	// Same cone as last time => Keep the cached result
+	if (emitter.bHasCone && emitter.Query == Query && emitter.Cone.Equals(Cone)) return;
+
+	emitter.bHasCone = true;
+	emitter.bConeChanged = true;
+	emitter.Cone = Cone;
+	emitter.Query = Query;
+}
+
+void ULighterBlockSubsystem::SetEmitterHits(const int32 EmitterId, const FLighterBlockSet& HitSet)
+{
+	if (!Emitters.IsValidIndex(EmitterId) || !Emitters[EmitterId].bRegistered) return;
+	FLighterEmitter& emitter = Emitters[EmitterId];
+
+	emitter.bHasCone = false;
+	ApplyEmitterHits(emitter, HitSet);
+	CommitStagedBlocks();
+}
+
+void ULighterBlockSubsystem::ClearEmitter(const int32 EmitterId)
+{
+	if (!Emitters.IsValidIndex(EmitterId) || !Emitters[EmitterId].bRegistered) return;
+	FLighterEmitter& emitter = Emitters[EmitterId];
+
+	emitter.bHasCone = false;
+	for (const int32 blockIndex : emitter.LitSet.GetMembers())
+		RemoveLight(blockIndex);
+	emitter.LitSet.Reset();
+}
+
+// A block came or went => Only the cones it's inside of have a stale result
+// (Visibility cones too, it might have been hiding something)
+
+void ULighterBlockSubsystem::InvalidateEmitters(const FBox2D& Bounds)
+{
+	for (FLighterEmitter& emitter : Emitters)
+		if (emitter.bRegistered && emitter.bHasCone && !emitter.bConeChanged && emitter.Cone.GetBounds().Intersect(Bounds))
+			emitter.bConeChanged = true;
+}
+
+void ULighterBlockSubsystem::AddLight(const int32 BlockIndex)
+{
+	if (!Store.AddLight(BlockIndex)) return;
+
+	++NumLitBlocks;
+	SetTargetCollisionResponse(BlockIndex, ECR_Block);
+
+	// Predicted => Doesn't wait for the dirty list (See CommitStagedBlocks)
+	const bool bStaged = StagedBlocks.Remove(BlockIndex);
+	if (bStaged && Store.HasPendingChange(BlockIndex))
+		CommitQueue.Add(BlockIndex);
+	StampLit(BlockIndex, bStaged);
+}
+
+void ULighterBlockSubsystem::RemoveLight(const int32 BlockIndex)
+{
+	if (!Store.RemoveLight(BlockIndex)) return;
+
+	--NumLitBlocks;
+	SetTargetCollisionResponse(BlockIndex, ECR_Overlap);
+	if (LitStamps.IsValidIndex(BlockIndex))
+		LitStamps[BlockIndex] = FLitStamp();
+}
+
+// The emitter's old contribution vs its new one
+// Same linear diff as the Tracer's LITSET / HITSET
+
+void ULighterBlockSubsystem::ApplyEmitterHits(FLighterEmitter& Emitter, const FLighterBlockSet& HitSet)
+{
+	AddedScratch.Reset();
+	RemovedScratch.Reset();
+	Emitter.LitSet.Diff(HitSet, AddedScratch, RemovedScratch);
+
+	// The aim behind these hits is traced now, the blocks it lights carry it on to physics
+	if (Emitter.InputTrace != 0)
+	{
+		const double now = FPlatformTime::Seconds();
+		LightingTrace = InputLatency.IsAlive(Emitter.InputTrace, now) ? Emitter.InputTrace : 0;
+		InputLatency.Reach(LightingTrace, ELighterLatencyStage::Traced, now);
+	}
+
+	for (const int32 blockIndex : AddedScratch)
+		AddLight(blockIndex);
+	LightingTrace = 0;
+	for (const int32 blockIndex : RemovedScratch)
+		RemoveLight(blockIndex);
+
+	// Rebuild from the members (Linear in the set sizes, never in the level size)
+	Emitter.LitSet.Reset();
+	for (const int32 blockIndex : HitSet.GetMembers())
+		Emitter.LitSet.Add(blockIndex);
+}
+
+
+
+/*
+* BATCHED PASS
+* ------------
+* 1. Only cone emitters whose cone moved, or had a block come or go inside it, need any work
+* 2. Group them into CLUSTERS of overlapping cone bounds
+* 3. ONE grid query per cluster, every emitter in it narrows that shared candidate list down
+*
+* NOTE: Split-screen players & lamp rows light the same area, so they end up sharing one query
+*/
+
+void ULighterBlockSubsystem::UpdateEmitters()
+{
+	PendingEmitters.Reset();
+	for (int32 emitterId = 0; emitterId < Emitters.Num(); ++emitterId)
+	{
+		const FLighterEmitter& emitter = Emitters[emitterId];
+		if (emitter.bRegistered && emitter.bHasCone && emitter.bConeChanged)
+			PendingEmitters.Add(emitterId);
+	}
+	if (PendingEmitters.Num() == 0) return;
+
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterUpdateEmitters);
+
+	while (PendingEmitters.Num() > 0)
+	{
+		// 2. Greedy cluster around the first pending emitter
+		ClusterEmitters.Reset();
+		ClusterEmitters.Add(PendingEmitters.Pop(false));
+		FBox2D clusterBounds = Emitters[ClusterEmitters[0]].Cone.GetBounds();
+
+		for (int32 i = PendingEmitters.Num() - 1; i >= 0; --i)
+		{
+			const FBox2D coneBounds = Emitters[PendingEmitters[i]].Cone.GetBounds();
+			if (coneBounds.Intersect(clusterBounds))
+			{
+				clusterBounds += coneBounds;
+				ClusterEmitters.Add(PendingEmitters[i]);
+				PendingEmitters.RemoveAtSwap(i, 1, false);
+			}
+		}
+
+		// 3. Shared broad phase
+		ClusterCandidates.Reset();
+		Grid.QueryBox(clusterBounds, Store, ClusterCandidates);
+
+		for (const int32 emitterId : ClusterEmitters)
+		{
+			FLighterEmitter& emitter = Emitters[emitterId];
+			const FBox2D coneBounds = emitter.Cone.GetBounds();
+
+			EmitterCandidates.Reset();
+			for (const int32 blockIndex : ClusterCandidates)
+			{
+				if (Store.Intersects(blockIndex, coneBounds) && emitter.Cone.Intersects(Store.GetBounds(blockIndex)))
+					EmitterCandidates.Add(blockIndex);
+			}
+
+			EmitterHits.Reset();
+			if (emitter.Query == ELighterEmitterQuery::Visibility)
+			{
+				CandidateBounds.Reset();
+				for (const int32 blockIndex : EmitterCandidates)
+					CandidateBounds.Add(Store.GetBounds(blockIndex));
+
+				VisibleCandidates.Reset();
+				Visibility.Compute(emitter.Cone, CandidateBounds, VisibleCandidates);
+				for (const int32 candidate : VisibleCandidates)
+					EmitterHits.Add(EmitterCandidates[candidate]);
+			}
+			else
+			{
+				for (const int32 blockIndex : EmitterCandidates)
+					EmitterHits.Add(blockIndex);
+			}
+
+			ApplyEmitterHits(emitter, EmitterHits);
+			emitter.bConeChanged = false;
+		}
+	}
+
+	CommitStagedBlocks();
+}
+#pragma endregion EMITTERS
+////////////////////////////////////////////////////////////////////// EMITTERS
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// PRE-LIGHTING
+#pragma region PRE-LIGHTING
+int32 ULighterBlockSubsystem::GetPrelightFrames()
+{
+	return CVarLighterPrelight.GetValueOnGameThread() != 0 ? FMath::Max(0, CVarLighterPrelightFrames.GetValueOnGameThread()) : 0;
+}
+
+void ULighterBlockSubsystem::StagePrelight(const TArray<FLighterCone>& Cones, const int32 Frames)
+{
+	LIGHTER_LLM_SCOPE();
+	if (Cones.Num() == 0) return;
+
+	// Shared broad phase, then whatever any of the cones actually reaches
+	FBox2D bounds(ForceInit);
+	for (const FLighterCone& cone : Cones)
+		bounds += cone.GetBounds();
+
+	StageScratch.Reset();
+	Grid.QueryBox(bounds, Store, StageScratch);
+
+	int32 numReached = 0;
+	for (const int32 blockIndex : StageScratch)
+	{
+		const FBox2D blockBounds = Store.GetBounds(blockIndex);
+		for (const FLighterCone& cone : Cones)
+			if (cone.Intersects(blockBounds))
+			{
+				StageScratch[numReached++] = blockIndex;
+				break;
+			}
+	}
+	StageScratch.SetNum(numReached, false);
+
+	StageBlocks(StageScratch, Frames);
+}
+
+// Every ball has ticked (Aim & cone set), physics hasn't started
+// Staging everyone first & resolving after keeps the cross-ball clusters of UpdateEmitters intact
+
+void ULighterBlockSubsystem::UpdatePrelight()
+{
+	const int32 frames = GetPrelightFrames();
+	if (frames <= 0) return;
+
+	for (ATheLighterBall* ball : Balls)
+		if (ball && ball->IsTracedLocally())
+			ball->StagePrelight(frames);
+
+	UpdateEmitters();
+}
+
+void ULighterBlockSubsystem::StageBlocks(const TArray<int32>& BlockIndices, const int32 Frames)
+{
+	const uint64 stagedUntil = GFrameCounter + Frames;
+	for (const int32 blockIndex : BlockIndices)
+	{
+		// Already lit => Nothing left to predict
+		if (Store.GetLitCount(blockIndex) > 0) continue;
+
+		if (StagedUntil.Num() <= blockIndex)
+			StagedUntil.SetNumZeroed(Slots.Num());
+		StagedUntil[blockIndex] = FMath::Max(StagedUntil[blockIndex], stagedUntil);
+
+		if (StagedBlocks.Add(blockIndex))
+			++PrelightStats.Staged;
+	}
+}
+
+// Wherever the light came from (A ball's Tracer before physics, the batched pass after it)
+// Only the few blocks a ball is about to need come through here, everything else stays batched on the dirty list
+
+void ULighterBlockSubsystem::CommitStagedBlocks()
+{
+	if (CommitQueue.Num() == 0) return;
+
+	ResolveBlocks(CommitQueue);
+	for (const int32 blockIndex : CommitQueue)
+		if (!Store.HasPendingChange(blockIndex))
+			++PrelightStats.Committed;
+	CommitQueue.Reset();
+}
+
+void ULighterBlockSubsystem::ExpireStagedBlocks()
+{
+	// Backwards => The swap that fills the gap brings in one we've already checked
+	const TArray<int32>& staged = StagedBlocks.GetMembers();
+	for (int32 i = staged.Num() - 1; i >= 0; --i)
+		if (StagedUntil[staged[i]] < GFrameCounter)
+			StagedBlocks.Remove(staged[i]);
+}
+
+void ULighterBlockSubsystem::StampLit(const int32 BlockIndex, const bool bStaged)
+{
+	if (LitStamps.Num() <= BlockIndex)
+		LitStamps.SetNum(Slots.Num());
+
+	FLitStamp& stamp = LitStamps[BlockIndex];
+	stamp.Frame = GFrameCounter;
+	stamp.Time = FPlatformTime::Seconds();
+	stamp.bStaged = bStaged;
+	stamp.InputTrace = LightingTrace;
+}
+
+// Start of the frame's physics (Game thread)
+// Everything that went solid since the last step is in this one => That's the block's real latency
+
+void ULighterBlockSubsystem::OnPhysScenePreTick(FPhysScene* PhysScene, float DeltaSeconds)
+{
+	// Whatever this commits is in the step below
+	UpdatePrelight();
+
+	const double now = FPlatformTime::Seconds();
+	for (const FLitStamp& stamp : AwaitingPhysics)
+	{
+		const int32 frames = (int32)FMath::Min<uint64>(GFrameCounter - stamp.Frame, FLighterPrelightStats::MaxFrames - 1);
+		const double ms = (now - stamp.Time) * 1000.0;
+
+		++PrelightStats.Frames[stamp.bStaged][frames];
+		PrelightStats.TotalMs[stamp.bStaged] += ms;
+		PrelightStats.MaxMs[stamp.bStaged] = FMath::Max(PrelightStats.MaxMs[stamp.bStaged], ms);
+
+		// Input => Collision
+		InputLatency.Reach(stamp.InputTrace, ELighterLatencyStage::Simulated, now);
+	}
+	AwaitingPhysics.Reset();
+
+	// Forces & jumps applied since the last step
+	InputLatency.OnPhysicsStep(now);
+}
+#pragma endregion PRE-LIGHTING
+////////////////////////////////////////////////////////////////////// PRE-LIGHTING
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// INPUT LATENCY
+#pragma region INPUT LATENCY
+void ULighterBlockSubsystem::SetEmitterInputTrace(const int32 EmitterId, const uint32 Trace)
+{
+	if (Emitters.IsValidIndex(EmitterId) && Emitters[EmitterId].bRegistered)
+		Emitters[EmitterId].InputTrace = Trace;
+}
+
+uint32 ULighterBlockSubsystem::GetBlockInputTrace(const int32 BlockIndex) const
+{
+	return IsBlockLit(BlockIndex) && LitStamps.IsValidIndex(BlockIndex) ? LitStamps[BlockIndex].InputTrace : 0;
+}
+#pragma endregion INPUT LATENCY
+////////////////////////////////////////////////////////////////////// INPUT LATENCY
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// TICK
+#pragma region TICK
+void ULighterBlockSubsystem::Deinitialize()
+{
+	if (FPhysScene* physScene = GetWorld()->GetPhysicsScene())
+		physScene->OnPhysScenePreTick.Remove(PhysScenePreTickHandle);
+	PhysScenePreTickHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+void ULighterBlockSubsystem::Tick(float DeltaTime)
+{
+	LIGHTER_LLM_SCOPE();
+
+	// The physics scene doesn't exist yet when we're created
+	if (!PhysScenePreTickHandle.IsValid())
+		if (FPhysScene* physScene = GetWorld()->GetPhysicsScene())
+			PhysScenePreTickHandle = physScene->OnPhysScenePreTick.AddUObject(this, &ULighterBlockSubsystem::OnPhysScenePreTick);
+
+	// Overlaps are done for the frame (Every substep included)
+	// => Each ball's queued exits go out as one impulse, whatever order physics reported them in
+	for (ATheLighterBall* ball : Balls)
+		if (ball)
+			ball->ResolveExitImpulses();
+
+	UpdateStreaming();
+	UpdateEmitters();
+	ResolveDirtyBlocks();
+	FlushLitVisuals();
+	ExpireStagedBlocks();
+
+	if (Emitters.Num() > FreeEmitters.Num())
+	{
+		LIGHTER_INC_COUNTER(STAT_LighterLitBlocks, NumLitBlocks);
+	}
+}
+
+TStatId ULighterBlockSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULighterBlockSubsystem, STATGROUP_Tickables);
+}
+
+ETickableTickType ULighterBlockSubsystem::GetTickableTickType() const
+{
+	// The CDO registers as a tickable too, keep it out of the loop
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool ULighterBlockSubsystem::IsTickable() const
+{
+	return DirtyBlocks.Num() > 0 || LitVisualFields.Num() > 0 || Balls.Num() > 0 || StreamingUnits.Num() > FreeStreamingUnits.Num() || Emitters.Num() > FreeEmitters.Num();
+}
+#pragma endregion TICK
+////////////////////////////////////////////////////////////////////// TICK
@@ -0,0 +1,495 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Central manager for every LighterBlock in the world
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "LighterBlockGrid.h"
+#include "LighterBlockStore.h"
+#include "LighterBlockSet.h"
+#include "LighterVisibility.h"
+#include "LighterCheckpoint.h"
+#include "LighterInputLatency.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "LighterBlockSubsystem.generated.h"
+
+
+/*
+* The LighterBlocks used to poll their own collision state on every Tick
+* That's one GetOverlappingActors() per block per frame, even when nothing changed
+*
+* Instead, this subsystem OWNS the list of blocks and keeps a DIRTY LIST
+* of the ones that have a pending collision change
+*
+* 1. The Tracer changes a block's TargetCollisionResponse	=> Block goes DIRTY
+* 2. Once per frame we try to resolve every DIRTY block
+* 		a. If any ball is still inside it, it gets PARKED (No more work until it exits)
+* 		b. Otherwise the collision preset is applied & the block leaves the list
+* 3. The block's EndOverlap puts a PARKED block back on the DIRTY list
+*
+* NOTE: Idle blocks cost NOTHING per frame
+*
+*
+* A "block" here is either
+* 		a. An ABlock actor
+* 		b. One instance of an ABlockField
+* Both get a BlockIndex, so the Tracer never has to care which one it's looking at
+*
+* Bounds, responses, lit counts & dirty / parked flags for every BlockIndex live in ONE FLighterBlockStore
+* The actors only own their physics bodies (See LighterBlockStore.h)
+*
+*
+* STREAMING
+* ---------
+* Levels scroll along Y, so the blocks are bucketed into CHUNKS along Y
+* Only the chunks around the balls (Pushed ahead by their velocity) are AWAKE
+*
+* 		DORMANT	=> Out of the grid & unlit, components unregistered (No physics bodies, no render state)
+* 		AWAKE	=> Normal LighterBlock
+*
+* Waking & sleeping is queued & time-sliced (Lighter.Streaming.BudgetMs per frame)
+* Nearest units first, so the blocks the ball reaches next are always ready first
+*
+* A streaming UNIT is an ABlock or a whole ABlockField (Fields can span several chunks)
+*
+*
+* EMITTERS
+* --------
+* Any number of lights (PlayerBalls, AI balls, ALighterLamps) can light the same blocks
+* Every block keeps a LIT COUNT => Solid while at least one emitter reaches it
+*
+* 		a. Cone emitters		=> Hand in their cone, ALL of them get resolved in ONE batched pass per frame
+* 								   Emitters with overlapping cones share a single grid query
+* 								   An emitter whose cone & the block registry didn't change costs nothing (Static lamps)
+* 		b. Self-traced emitters	=> Trace on their own (RayFan) & hand in their HITSET
+*
+* Either way only the 0 <=> 1 lit count transitions toggle any collision
+*
+*
+* CHECKPOINTS
+* -----------
+* The whole gameplay state (Blocks, emitters & balls) in one FLighterCheckpoint, restored in place (See LighterCheckpoint.h)
+*
+*
+* PRE-LIGHTING
+* ------------
+* A lit block normally waits for the DIRTY LIST, which runs after physics => The ball can't land on it until next frame
+* Right before physics, every ball projects its tracer & trajectory Lighter.Prelight.Frames ahead & STAGES the blocks its cone is about to reach
+* (One grid query a ball, none for a ball that's resting), then ONE batched pass resolves every cone emitter
+*
+* 		Staged block gets lit	=> COMMITTED right there (Before physics when it's the ball lighting it)
+* 		Anything else			=> Dirty list, same as before
+*
+* Staging never makes anything solid on its own, it only decides who gets to skip the queue
+*/
+
+
+// One registered LighterBlock
+USTRUCT()
+struct FLighterBlockSlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		class ABlock* Block = nullptr;
+
+	UPROPERTY()
+		class ABlockField* Field = nullptr;
+
+	int32 InstanceIndex = INDEX_NONE;
+
+	FORCEINLINE bool IsValid() const { return Block || Field; }
+};
+
+
+// One ABlock or ABlockField, as the streaming sees it
+USTRUCT()
+struct FLighterStreamingUnit
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		class ABlock* Block = nullptr;
+
+	UPROPERTY()
+		class ABlockField* Field = nullptr;
+
+	// Chunks it touches (Inclusive)
+	int32 MinChunk = 0;
+	int32 MaxChunk = -1;
+
+	bool bDormant = false;
+	bool bQueued = false;
+
+	FORCEINLINE bool IsValid() const { return Block || Field; }
+	FORCEINLINE bool Overlaps(const int32 InMinChunk, const int32 InMaxChunk) const { return MinChunk <= InMaxChunk && MaxChunk >= InMinChunk; }
+};
+
+
+// How the batched pass resolves a cone emitter
+enum class ELighterEmitterQuery : uint8
+{
+	Cone,			// Everything inside the cone
+	Visibility		// Only what the light reaches (Blocks occlude each other)
+};
+
+
+// One light source
+struct FLighterEmitter
+{
+	bool bRegistered = false;
+
+	// Cone emitters only
+	bool bHasCone = false;
+	bool bConeChanged = false;
+	FLighterCone Cone;
+	ELighterEmitterQuery Query = ELighterEmitterQuery::Cone;
+
+	// What this emitter is currently contributing to the lit counts
+	FLighterBlockSet LitSet;
+
+	// The input behind its current aim (See LighterInputLatency.h)
+	uint32 InputTrace = 0;
+};
+
+
+// Lit => Solid in a physics step (Lighter.Prelight.Stats)
+struct FLighterPrelightStats
+{
+	static constexpr int32 MaxFrames = 4;
+
+	// [Staged][Frames] => Blocks whose collision took that many frames (Last one => That many or more)
+	uint32 Frames[2][MaxFrames] = {};
+	double TotalMs[2] = {};
+	double MaxMs[2] = {};
+
+	// Blocks a prediction staged & how many of those got lit & committed
+	uint32 Staged = 0;
+	uint32 Committed = 0;
+
+	void Reset() { *this = FLighterPrelightStats(); }
+};
+
+
+UCLASS()
+class ULighterBlockSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+#pragma region REGISTRY
+public:
+	void RegisterBlock(class ABlock* Block);
+	void UnregisterBlock(class ABlock* Block);
+
+	// The block's actor was just moved by Offset => Its bounds, grid cells & streaming chunks follow
+	// Stays registered, so its lit count, response, lit visual & every emitter's LITSET carry over
+	void ShiftBlock(class ABlock* Block, const FVector& Offset);
+
+	// Instances of an ABlockField (Returns the BlockIndex)
+	int32 RegisterInstance(class ABlockField* Field, const int32 InstanceIndex, const FBox2D& Bounds);
+	void UnregisterInstance(const int32 BlockIndex);
+
+	FORCEINLINE int32 GetNumBlocks() const { return Slots.Num() - FreeIndices.Num(); }
+	FORCEINLINE int32 GetNumSlots() const { return Slots.Num(); }
+	FORCEINLINE const FLighterBlockSlot* GetSlot(const int32 BlockIndex) const { return Slots.IsValidIndex(BlockIndex) && Slots[BlockIndex].IsValid() ? &Slots[BlockIndex] : nullptr; }
+	FORCEINLINE class ABlock* GetBlock(const int32 BlockIndex) const { return Slots.IsValidIndex(BlockIndex) ? Slots[BlockIndex].Block : nullptr; }
+	FORCEINLINE FBox2D GetBlockBounds(const int32 BlockIndex) const { return Store.GetBounds(BlockIndex); }
+	FORCEINLINE const FLighterBlockStore& GetStore() const { return Store; }
+
+	// Maps a Lighter channel hit (ABlock or ABlockField instance) to its BlockIndex
+	int32 GetBlockIndexFromHit(const FHitResult& Hit) const;
+
+private:
+	int32 AllocateIndex();
+	void FreeIndex(const int32 BlockIndex);
+
+	// Drops the block's lit state & grid cells, the slot itself is left alone
+	void ForgetBlock(const int32 BlockIndex);
+
+	// Indexed by BlockIndex
+	// Indices are STABLE for the lifetime of a block, freed slots get reused
+	UPROPERTY(Transient)
+		TArray<FLighterBlockSlot> Slots;
+	TArray<int32> FreeIndices;
+
+	// Same indices as Slots
+	FLighterBlockStore Store;
+#pragma endregion
+
+
+
+
+#pragma region COLLISION
+public:
+	// Works for both ABlocks & ABlockField instances
+	void SetTargetCollisionResponse(const int32 BlockIndex, const ECollisionResponse CollisionResponse);
+
+	// A ball left the block => A PARKED block gets another go
+	void OnBallEndOverlap(const int32 BlockIndex);
+
+	// Lit fades of the frame => Batched render state updates (See LighterLitVisuals.h)
+	void FlushLitVisuals();
+
+	FORCEINLINE bool IsBlockSolid(const int32 BlockIndex) const { return Store.IsValid(BlockIndex) && Store.IsSolid(BlockIndex); }
+	FORCEINLINE bool HasPendingCollisionChange(const int32 BlockIndex) const { return Store.IsValid(BlockIndex) && Store.HasPendingChange(BlockIndex); }
+
+	// Every ATheLighterBall parks the blocks it's inside of & gets their ExitImpulse
+	// Exits queued during physics are resolved once per frame in Tick
+	void RegisterBall(class ATheLighterBall* Ball);
+	void UnregisterBall(class ATheLighterBall* Ball);
+	FORCEINLINE const TArray<class ATheLighterBall*>& GetBalls() const { return Balls; }
+
+private:
+	bool IsOverlappedByBall(const FLighterBlockSlot& Slot) const;
+	void ApplyCollision(const int32 BlockIndex, const bool bSolid);
+	void WriteLitVisual(const int32 BlockIndex, const bool bLit);
+
+	// Fields with per-instance custom data written this frame
+	UPROPERTY(Transient)
+		TArray<class ABlockField*> LitVisualFields;
+
+	UPROPERTY(Transient)
+		TArray<class ATheLighterBall*> Balls;
+#pragma endregion
+
+
+
+
+#pragma region EMITTERS
+public:
+	int32 RegisterEmitter();
+	void UnregisterEmitter(const int32 EmitterId);
+
+	// Cone emitters => Resolved in the batched pass (UpdateEmitters)
+	void SetEmitterCone(const int32 EmitterId, const FLighterCone& Cone, const ELighterEmitterQuery Query);
+
+	// Self-traced emitters => Applied right away
+	void SetEmitterHits(const int32 EmitterId, const FLighterBlockSet& HitSet);
+
+	// Light off
+	void ClearEmitter(const int32 EmitterId);
+
+	// Resolve every cone emitter that needs it
+	void UpdateEmitters();
+
+	FORCEINLINE const FLighterBlockSet* GetEmitterLitSet(const int32 EmitterId) const { return Emitters.IsValidIndex(EmitterId) && Emitters[EmitterId].bRegistered ? &Emitters[EmitterId].LitSet : nullptr; }
+	FORCEINLINE bool IsBlockLit(const int32 BlockIndex) const { return Store.IsValid(BlockIndex) && Store.GetLitCount(BlockIndex) > 0; }
+	FORCEINLINE int32 GetNumLitBlocks() const { return NumLitBlocks; }
+
+	// Changes whenever a block gets registered or unregistered
+	FORCEINLINE uint32 GetRegistryVersion() const { return RegistryVersion; }
+
+private:
+	void ApplyEmitterHits(FLighterEmitter& Emitter, const FLighterBlockSet& HitSet);
+	void InvalidateEmitters(const FBox2D& Bounds);
+	void AddLight(const int32 BlockIndex);
+	void RemoveLight(const int32 BlockIndex);
+
+	TArray<FLighterEmitter> Emitters;
+	TArray<int32> FreeEmitters;
+	int32 NumLitBlocks = 0;
+
+	// Bumped on every register / unregister => The replicator rebuilds its net order
+	// (Cone emitters don't care, InvalidateEmitters only touches the ones around the block)
+	uint32 RegistryVersion = 1;
+
+	// Reused by the batched pass
+	FLighterVisibility Visibility;
+	FLighterBlockSet EmitterHits;
+	TArray<int32> PendingEmitters;
+	TArray<int32> ClusterEmitters;
+	TArray<int32> ClusterCandidates;
+	TArray<int32> EmitterCandidates;
+	TArray<FBox2D> CandidateBounds;
+	TArray<int32> VisibleCandidates;
+	TArray<int32> AddedScratch;
+	TArray<int32> RemovedScratch;
+#pragma endregion
+
+
+
+
+#pragma region DIRTY LIST
+public:
+	// Queue a block for collision resolution
+	void MarkDirty(const int32 BlockIndex);
+
+	// Apply every pending collision change that's allowed right now
+	void ResolveDirtyBlocks();
+
+	FORCEINLINE int32 GetNumDirtyBlocks() const { return DirtyBlocks.Num(); }
+
+private:
+	// Overlapped by a ball => PARKED, otherwise applied (One scene write lock for all of them)
+	void ResolveBlocks(const TArray<int32>& BlockIndices);
+
+	// Dirty bits are in the Store
+	TArray<int32> DirtyBlocks;
+#pragma endregion
+
+
+
+
+#pragma region CHECKPOINTS
+public:
+	// Everything, into / from the given checkpoint
+	void CaptureCheckpoint(FLighterCheckpoint& OutCheckpoint) const;
+	void RestoreCheckpoint(const FLighterCheckpoint& Checkpoint);
+
+	// The one checkpoint the game respawns at
+	void SaveCheckpoint() { CaptureCheckpoint(Checkpoint); }
+	bool LoadCheckpoint();
+	void ClearCheckpoint() { Checkpoint.bValid = false; }
+	FORCEINLINE const FLighterCheckpoint& GetCheckpoint() const { return Checkpoint; }
+
+private:
+	void CaptureBlocks(FLighterBlockSnapshot& OutSnapshot) const;
+	void RestoreBlocks(const FLighterBlockSnapshot& Snapshot);
+
+	FLighterCheckpoint Checkpoint;
+
+	// Blocks whose body gets put back (Reused)
+	TArray<int32> RestoreScratch;
+#pragma endregion
+
+
+
+
+#pragma region SPATIAL QUERIES
+public:
+	// Index of every registered block that intersects the cone (Exact test, no rays involved)
+	void QueryCone(const FLighterCone& Cone, TArray<int32>& OutBlockIndices) const;
+
+private:
+	// Blocks are Stationary, so they go in once on register & come out on unregister
+	// (Or while their streaming unit is DORMANT, a Rebase Shift moves them between cells)
+	FLighterBlockGrid Grid;
+#pragma endregion
+
+
+
+
+#pragma region STREAMING
+public:
+	// Returns the unit id (Store it for Unregister)
+	int32 RegisterStreamingUnit(class ABlock* Block, class ABlockField* Field, const FBox2D& Bounds);
+	void UnregisterStreamingUnit(const int32 UnitId);
+
+	// Move the AWAKE window with the PlayerBall & work off the queue
+	void UpdateStreaming();
+
+	FORCEINLINE int32 GetNumAwakeUnits() const { return NumAwakeUnits; }
+
+	// Width of a chunk along Y
+	float ChunkSize = 2000.f;
+
+private:
+	FORCEINLINE int32 GetChunk(const float Y) const { return FMath::FloorToInt(Y / ChunkSize); }
+	void QueueStreamingUnit(const int32 UnitId);
+	void AddUnitToChunks(const int32 UnitId, const FBox2D& Bounds);
+	void RemoveUnitFromChunks(const int32 UnitId);
+	void SetUnitDormant(FLighterStreamingUnit& Unit, const bool bDormant);
+	void SetBlockDormant(const int32 BlockIndex, const bool bDormant);
+
+	template <typename FuncType>
+	void ForEachUnitBlock(const FLighterStreamingUnit& Unit, FuncType Func) const;
+
+	UPROPERTY(Transient)
+		TArray<FLighterStreamingUnit> StreamingUnits;
+	TArray<int32> FreeStreamingUnits;
+
+	// Chunk => Units touching it
+	TMap<int32, TArray<int32>> Chunks;
+
+	// AWAKE window (Inclusive), invalid until the first update
+	bool bHasStreamingWindow = false;
+	int32 WindowMinChunk = 0;
+	int32 WindowMaxChunk = -1;
+
+	TArray<int32> StreamingQueue;
+	int32 NumAwakeUnits = 0;
+#pragma endregion
+
+
+
+
+#pragma region PRE-LIGHTING
+public:
+	// Blocks any of the cones is going to reach within the next Frames frames (One per frame ahead, from each ball)
+	void StagePrelight(const TArray<FLighterCone>& Cones, const int32 Frames);
+
+	// Same, for blocks the ball already found (The substep tracer => 0 Frames, committed this frame or never)
+	void StageBlocks(const TArray<int32>& BlockIndices, const int32 Frames);
+
+	// Lighter.Prelight.Frames, 0 when Lighter.Prelight is off
+	static int32 GetPrelightFrames();
+
+	FORCEINLINE int32 GetNumStagedBlocks() const { return StagedBlocks.Num(); }
+	FORCEINLINE const FLighterPrelightStats& GetPrelightStats() const { return PrelightStats; }
+	void ResetPrelightStats() { PrelightStats.Reset(); }
+
+private:
+	// Right before physics => Every ball stages, then ONE batched emitter pass for all of them
+	void UpdatePrelight();
+
+	// Staged blocks lit since the last call => Solid now
+	void CommitStagedBlocks();
+	void ExpireStagedBlocks();
+
+	// Lit => Solid bookkeeping for the latency stats
+	void StampLit(const int32 BlockIndex, const bool bStaged);
+	void OnPhysScenePreTick(FPhysScene* PhysScene, float DeltaSeconds);
+
+	FLighterBlockSet StagedBlocks;
+	TArray<uint64> StagedUntil;								// Indexed by BlockIndex => Last frame it stays staged
+	TArray<int32> CommitQueue;
+	TArray<int32> StageScratch;
+
+	struct FLitStamp
+	{
+		uint64 Frame = 0;
+		double Time = 0.0;									// 0 => Not waiting on its collision
+		bool bStaged = false;
+		uint32 InputTrace = 0;								// The input whose aim lit it (Kept while it stays lit)
+	};
+	TArray<FLitStamp> LitStamps;							// Indexed by BlockIndex
+	TArray<FLitStamp> AwaitingPhysics;						// Solid now, the next physics step is the first to have it
+
+	FLighterPrelightStats PrelightStats;
+	FDelegateHandle PhysScenePreTickHandle;
+#pragma endregion
+
+
+
+
+#pragma region INPUT LATENCY
+public:
+	FORCEINLINE FLighterInputLatency& GetInputLatency() { return InputLatency; }
+	FORCEINLINE const FLighterInputLatency& GetInputLatency() const { return InputLatency; }
+
+	// The input the emitter's next hits come from => The blocks they light get charged to it
+	void SetEmitterInputTrace(const int32 EmitterId, const uint32 Trace);
+
+	// The input whose aim lit this block, 0 when there's none
+	uint32 GetBlockInputTrace(const int32 BlockIndex) const;
+
+private:
+	FLighterInputLatency InputLatency;
+	uint32 LightingTrace = 0;								// Set while an emitter's hits get applied (AddLight stamps it)
+#pragma endregion
+
+
+
+
+#pragma region TICK
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+#pragma endregion
+};
@@ -0,0 +1,100 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Snapshot of the gameplay state, restored in place (No level reload)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+
+
+/*
+* Respawning used to mean reloading the level, or resetting actors one by one from Blueprints
+* A CHECKPOINT is everything the gameplay needs to be back where it was
+*
+* 		BLOCKS	=> Valid, Solid (Current response) & TargetSolid bits		(3 bits per block, copied word by word)
+* 				   Every emitter's LITSET									(The lit counts are rebuilt from these)
+* 		BALLS	=> Physics transform, linear & angular velocity, GroundedTime, tracer rotations & the mode flags
+*
+* Restoring is a DIFF against the live state
+* Only the blocks whose response or lit state actually differs get touched, so taking one often is cheap
+*
+* NOTE: A checkpoint belongs to the level it was taken in (BlockIndices & EmitterIds aren't portable)
+*/
+
+
+struct FLighterBlockSnapshot
+{
+	TBitArray<> Valid;
+	TBitArray<> Solid;
+	TBitArray<> TargetSolid;
+
+	// Indexed by EmitterId (Empty => Not registered / not lighting anything)
+	TArray<TArray<int32>> EmitterLitSets;
+
+	void Reset()
+	{
+		Valid.Empty();
+		Solid.Empty();
+		TargetSolid.Empty();
+		EmitterLitSets.Reset();
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FLighterBlockSnapshot& Snapshot)
+	{
+		Ar << Snapshot.Valid << Snapshot.Solid << Snapshot.TargetSolid;
+		Ar << Snapshot.EmitterLitSets;
+		return Ar;
+	}
+};
+
+
+struct FLighterBallSnapshot
+{
+	TWeakObjectPtr<class ATheLighterBall> Ball;
+
+	FTransform Transform;
+	FVector LinearVelocity = FVector::ZeroVector;
+	FVector AngularVelocity = FVector::ZeroVector;		// Degrees
+	float GroundedTime = 0.f;
+	FRotator CurrentTracerRotation = FRotator::ZeroRotator;
+	FRotator TargetTracerRotation = FRotator::ZeroRotator;
+	uint8 TracerMode = 0;
+
+	// bDisableTracerControl, bDisableMovement, bDisableAirControl, bDisableJump, bDisableExitImpulse, bIsGrounded, bIsWalled
+	uint8 Flags = 0;
+
+	enum EFlags : uint8
+	{
+		DisableTracerControl	= 1 << 0,
+		DisableMovement			= 1 << 1,
+		DisableAirControl		= 1 << 2,
+		DisableJump				= 1 << 3,
+		DisableExitImpulse		= 1 << 4,
+		Grounded				= 1 << 5,
+		Walled					= 1 << 6
+	};
+
+	// The ball itself isn't serialized, a loaded snapshot is matched up by order
+	friend FArchive& operator<<(FArchive& Ar, FLighterBallSnapshot& Snapshot)
+	{
+		Ar << Snapshot.Transform << Snapshot.LinearVelocity << Snapshot.AngularVelocity << Snapshot.GroundedTime;
+		Ar << Snapshot.CurrentTracerRotation << Snapshot.TargetTracerRotation << Snapshot.TracerMode << Snapshot.Flags;
+		return Ar;
+	}
+};
+
+
+struct FLighterCheckpoint
+{
+	bool bValid = false;
+	float Time = 0.f;
+
+	FLighterBlockSnapshot Blocks;
+	TArray<FLighterBallSnapshot> Balls;
+
+	friend FArchive& operator<<(FArchive& Ar, FLighterCheckpoint& Checkpoint)
+	{
+		Ar << Checkpoint.bValid << Checkpoint.Time << Checkpoint.Blocks << Checkpoint.Balls;
+		return Ar;
+	}
+};
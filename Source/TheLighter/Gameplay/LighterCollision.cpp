@@ -0,0 +1,18 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Cheap collision toggling for the LighterBlocks
+
+#include "LighterCollision.h"
+#include "HAL/IConsoleManager.h"
+
+
+static TAutoConsoleVariable<int32> CVarLighterFastCollisionToggle(
+	TEXT("Lighter.FastCollisionToggle"),
+	1,
+	TEXT("1 => LighterBlocks swap a pre-built response container (One filter update, batched under one scene lock)\n")
+	TEXT("0 => LighterBlocks call SetCollisionResponseToChannel per channel"),
+	ECVF_Default);
+
+bool LighterCollision::UseFastToggle()
+{
+	return CVarLighterFastCollisionToggle.GetValueOnGameThread() != 0;
+}
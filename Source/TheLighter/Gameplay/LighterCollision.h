@@ -0,0 +1,48 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Cheap collision toggling for the LighterBlocks
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+
+/*
+* SetCollisionResponseToChannel() twice per toggle means
+* 		=> 2x physics filter rebuilds
+* 		=> 2x OnComponentCollisionSettingsChanged (Overlap refresh, proxy update, broadcast)
+*
+* A LighterBlock only ever flips between two states, so build both containers ONCE
+* and swap the whole container in => ONE filter update per toggle
+*
+* Lighter.FastCollisionToggle 0 => Back to the per-channel path (For comparison)
+*/
+
+struct FLighterCollisionResponses
+{
+	FCollisionResponseContainer Solid;			// Pawn & PhysicsBody => Block
+	FCollisionResponseContainer PassThrough;	// Pawn & PhysicsBody => Overlap
+
+	void Init(const FCollisionResponseContainer& BaseResponses)
+	{
+		Solid = BaseResponses;
+		Solid.SetResponse(ECC_Pawn, ECR_Block);
+		Solid.SetResponse(ECC_PhysicsBody, ECR_Block);
+
+		PassThrough = BaseResponses;
+		PassThrough.SetResponse(ECC_Pawn, ECR_Overlap);
+		PassThrough.SetResponse(ECC_PhysicsBody, ECR_Overlap);
+	}
+
+	FORCEINLINE const FCollisionResponseContainer& Get(const ECollisionResponse CollisionResponse) const
+	{
+		return CollisionResponse == ECR_Block ? Solid : PassThrough;
+	}
+};
+
+
+namespace LighterCollision
+{
+	// Lighter.FastCollisionToggle
+	bool UseFastToggle();
+}
@@ -0,0 +1,98 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Slot bookkeeping for ONE pooled effect type
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+* Only the bookkeeping, no components in here
+* The ULighterEffectSubsystem keeps one component per slot (Same index), so this can be checked without rendering
+*
+* 		Hit			=> A free slot got reused							(No component created)
+* 		Miss		=> No free slot, but under the cap => New slot		(Caller creates its component)
+* 		Evicted		=> At the cap => The OLDEST active slot restarts	(Caps concurrent instances)
+*
+* NOTE: Active slots are kept in acquire order, so the oldest is always at the front
+*/
+
+class FLighterEffectPool
+{
+public:
+	enum class EAcquire : uint8
+	{
+		Hit,
+		Miss,
+		Evicted
+	};
+
+	struct FStats
+	{
+		uint32 Hits = 0;
+		uint32 Misses = 0;
+		uint32 Evictions = 0;
+	};
+
+	explicit FLighterEffectPool(const int32 InMaxInstances = 8)
+		: MaxInstances(FMath::Max(1, InMaxInstances))
+	{}
+
+	// Pre-warmed slot, free from the start (Returns its index, INDEX_NONE at the cap)
+	int32 AddFreeSlot()
+	{
+		if (NumSlots >= MaxInstances) return INDEX_NONE;
+		Free.Push(NumSlots);
+		return NumSlots++;
+	}
+
+	// Slot for a new instance
+	int32 Acquire(EAcquire& OutResult)
+	{
+		int32 slot;
+		if (Free.Num() > 0)
+		{
+			slot = Free.Pop(false);
+			OutResult = EAcquire::Hit;
+			++Stats.Hits;
+		}
+		else if (NumSlots < MaxInstances)
+		{
+			slot = NumSlots++;
+			OutResult = EAcquire::Miss;
+			++Stats.Misses;
+		}
+		else
+		{
+			slot = Active[0];
+			Active.RemoveAt(0, 1, false);
+			OutResult = EAcquire::Evicted;
+			++Stats.Evictions;
+		}
+
+		Active.Add(slot);
+		return slot;
+	}
+
+	// The instance is done => Slot goes back on the free list (False if it wasn't active)
+	bool Release(const int32 Slot)
+	{
+		if (Active.RemoveSingle(Slot) == 0) return false;
+		Free.Push(Slot);
+		return true;
+	}
+
+	FORCEINLINE int32 GetNumSlots() const { return NumSlots; }
+	FORCEINLINE int32 GetNumActive() const { return Active.Num(); }
+	FORCEINLINE int32 GetNumFree() const { return Free.Num(); }
+	FORCEINLINE int32 GetMaxInstances() const { return MaxInstances; }
+	FORCEINLINE const FStats& GetStats() const { return Stats; }
+
+private:
+	int32 MaxInstances;
+	int32 NumSlots = 0;
+
+	TArray<int32> Free;
+	TArray<int32> Active;
+	FStats Stats;
+};
@@ -0,0 +1,141 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Pooled particle effects for the gameplay events (DoubleJump, ExitImpulse, ...)
+
+#include "LighterEffectSubsystem.h"
+#include "TheLighter.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "HAL/IConsoleManager.h"
+
+
+static TAutoConsoleVariable<int32> CVarLighterEffectsPrewarm(
+	TEXT("Lighter.Effects.Prewarm"),
+	4,
+	TEXT("Components created up front for every pooled effect type"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLighterEffectsMaxInstances(
+	TEXT("Lighter.Effects.MaxInstances"),
+	8,
+	TEXT("Concurrent instances per pooled effect type, the oldest one gets restarted past it (Applies to new pools)"),
+	ECVF_Default);
+
+
+
+
+////////////////////////////////////////////////////////////////////// POOLS
+#pragma region POOLS
+void ULighterEffectSubsystem::Deinitialize()
+{
+	for (TPair<UParticleSystem*, FLighterEffectPoolEntry>& pool : Pools)
+		for (UParticleSystemComponent* component : pool.Value.Components)
+			if (component)
+				component->DestroyComponent();
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+void ULighterEffectSubsystem::Prewarm(UParticleSystem* Template)
+{
+	if (!Template || Pools.Contains(Template)) return;
+	LIGHTER_LLM_SCOPE();
+
+	FLighterEffectPoolEntry& entry = FindOrAddPool(Template);
+	const int32 numPrewarm = CVarLighterEffectsPrewarm.GetValueOnGameThread();
+	for (int32 i = 0; i < numPrewarm && entry.Pool.AddFreeSlot() != INDEX_NONE; ++i)
+		entry.Components.Add(CreateComponent(Template));
+}
+
+FLighterEffectPoolEntry& ULighterEffectSubsystem::FindOrAddPool(UParticleSystem* Template)
+{
+	if (FLighterEffectPoolEntry* entry = Pools.Find(Template))
+		return *entry;
+
+	FLighterEffectPoolEntry& entry = Pools.Add(Template);
+	entry.Pool = FLighterEffectPool(CVarLighterEffectsMaxInstances.GetValueOnGameThread());
+	return entry;
+}
+
+UParticleSystemComponent* ULighterEffectSubsystem::CreateComponent(UParticleSystem* Template)
+{
+	// Same owner UGameplayStatics::SpawnEmitterAtLocation uses, but it never auto destroys
+	UWorld* world = GetWorld();
+	UParticleSystemComponent* component = NewObject<UParticleSystemComponent>(world->GetWorldSettings());
+	component->bAutoActivate = false;
+	component->bAutoDestroy = false;
+	component->SetUsingAbsoluteLocation(true);
+	component->SetUsingAbsoluteRotation(true);
+	component->SetUsingAbsoluteScale(true);
+	component->SetTemplate(Template);
+	component->OnSystemFinished.AddDynamic(this, &ULighterEffectSubsystem::OnEffectFinished);
+	component->RegisterComponentWithWorld(world);
+	return component;
+}
+#pragma endregion POOLS
+////////////////////////////////////////////////////////////////////// POOLS
+
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// DISPATCH
+#pragma region DISPATCH
+void ULighterEffectSubsystem::SpawnEffect(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation)
+{
+	UWorld* world = GetWorld();
+	if (!Template || !world || !world->IsGameWorld()) return;
+	LIGHTER_LLM_SCOPE();
+
+	FLighterEffectPoolEntry& entry = FindOrAddPool(Template);
+	FLighterEffectPool::EAcquire result;
+	const int32 slot = entry.Pool.Acquire(result);
+
+	switch (result)
+	{
+	case FLighterEffectPool::EAcquire::Hit:
+		LIGHTER_INC_COUNTER(STAT_LighterEffectPoolHits, 1);
+		break;
+	case FLighterEffectPool::EAcquire::Miss:
+		LIGHTER_INC_COUNTER(STAT_LighterEffectPoolMisses, 1);
+		check(slot == entry.Components.Num());
+		entry.Components.Add(CreateComponent(Template));
+		break;
+	case FLighterEffectPool::EAcquire::Evicted:
+		LIGHTER_INC_COUNTER(STAT_LighterEffectPoolEvictions, 1);
+		break;
+	}
+
+	UParticleSystemComponent* component = entry.Components[slot];
+	if (!component)
+	{
+		// Got destroyed under us (Level teardown), the slot's no good anymore
+		entry.Pool.Release(slot);
+		return;
+	}
+
+	component->SetWorldLocationAndRotation(Location, Rotation);
+
+	bRestarting = true;
+	component->Activate(true);
+	bRestarting = false;
+}
+
+void ULighterEffectSubsystem::OnEffectFinished(UParticleSystemComponent* Component)
+{
+	if (bRestarting || !Component) return;
+
+	FLighterEffectPoolEntry* entry = Pools.Find(Component->Template);
+	if (!entry) return;
+
+	const int32 slot = entry->Components.Find(Component);
+	if (slot != INDEX_NONE)
+		entry->Pool.Release(slot);
+}
+#pragma endregion DISPATCH
+////////////////////////////////////////////////////////////////////// DISPATCH
@@ -0,0 +1,70 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Pooled particle effects for the gameplay events (DoubleJump, ExitImpulse, ...)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LighterEffectPool.h"
+#include "LighterEffectSubsystem.generated.h"
+
+
+/*
+* The PlayerBall's events used to spawn their particles on the Blueprint side
+* That's a Blueprint VM dispatch + a new emitter component per event, destroyed again when it's done
+* Booster chains fire those many times a second
+*
+* Instead, every particle template (= Effect type) gets a POOL of components
+*
+* 		1. Prewarm		=> Lighter.Effects.Prewarm components get created up front (BeginPlay)
+* 		2. SpawnEffect	=> Move a free component to the spot & restart it
+* 		3. Finished		=> The component goes back to its pool (Never destroyed)
+*
+* Lighter.Effects.MaxInstances caps the concurrent instances per type, the oldest one gets restarted past it
+* Hits / Misses / Evictions show up in "stat TheLighter" & Lighter.Effects.Stats
+*/
+
+
+// Components of one pooled effect type
+USTRUCT()
+struct FLighterEffectPoolEntry
+{
+	GENERATED_BODY()
+
+	// Indexed by pool slot
+	UPROPERTY()
+		TArray<class UParticleSystemComponent*> Components;
+
+	FLighterEffectPool Pool;
+};
+
+
+UCLASS()
+class ULighterEffectSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Create the pre-warmed components for Template (No-op once its pool exists)
+	void Prewarm(class UParticleSystem* Template);
+
+	// Fire & forget, from the pool
+	void SpawnEffect(class UParticleSystem* Template, const FVector& Location, const FRotator& Rotation = FRotator::ZeroRotator);
+
+	FORCEINLINE const TMap<class UParticleSystem*, FLighterEffectPoolEntry>& GetPools() const { return Pools; }
+
+private:
+	FLighterEffectPoolEntry& FindOrAddPool(class UParticleSystem* Template);
+	class UParticleSystemComponent* CreateComponent(class UParticleSystem* Template);
+
+	UFUNCTION()
+		void OnEffectFinished(class UParticleSystemComponent* Component);
+
+	UPROPERTY(Transient)
+		TMap<class UParticleSystem*, FLighterEffectPoolEntry> Pools;
+
+	// An evicted component restarting mustn't hand its slot back
+	bool bRestarting = false;
+};
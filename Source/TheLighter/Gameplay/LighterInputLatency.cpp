@@ -0,0 +1,177 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Input => Effect latency, from the moment a sample arrives to the contact it causes
+
+#include "LighterInputLatency.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+static TAutoConsoleVariable<int32> CVarLighterInputLatency(
+	TEXT("Lighter.InputLatency"),
+	1,
+	TEXT("1 => Every input sample gets timestamped & followed to the tracer, the collision & the contact it causes (Lighter.Latency.Stats)\n")
+	TEXT("0 => Off"),
+	ECVF_Default);
+
+
+
+float FLighterLatencyHistogram::GetPercentileMs(const float Percentile) const
+{
+	if (Count == 0) return 0.f;
+
+	const uint64 target = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(Count * (double)Percentile / 100.0));
+	uint64 count = 0;
+	for (int32 bucket = 0; bucket < Buckets.Num(); ++bucket)
+	{
+		count += Buckets[bucket];
+		if (count >= target)
+			return (bucket + 1) / (float)FLighterInputLatency::BucketsPerMs;
+	}
+	return (float)FLighterInputLatency::MaxTraceMs;
+}
+
+
+
+FLighterInputLatency::FLighterInputLatency()
+{
+	Reset();
+}
+
+bool FLighterInputLatency::IsEnabled()
+{
+	return CVarLighterInputLatency.GetValueOnGameThread() != 0;
+}
+
+uint32 FLighterInputLatency::Begin(const ELighterInputSource Source, const double ArrivalTime)
+{
+	if (!IsEnabled()) return 0;
+
+	// 0 is "No trace"
+	const uint32 id = NextId;
+	NextId = NextId == MAX_uint32 ? 1 : NextId + 1;
+
+	FTrace& trace = Traces[id % MaxTraces];
+	trace.Id = id;
+	trace.Source = Source;
+	trace.ReachedStages = 0;
+	trace.Frame = GFrameCounter;
+	trace.ArrivalTime = ArrivalTime;
+
+	++NumTraces[(int32)Source];
+	return id;
+}
+
+bool FLighterInputLatency::IsAlive(const uint32 Trace, const double Time) const
+{
+	if (Trace == 0) return false;
+
+	const FTrace& trace = Traces[Trace % MaxTraces];
+	return trace.Id == Trace && (Time - trace.ArrivalTime) * 1000.0 <= MaxTraceMs;
+}
+
+void FLighterInputLatency::Reach(const uint32 Trace, const ELighterLatencyStage Stage, const double Time)
+{
+	if (!IsAlive(Trace, Time)) return;
+
+	FTrace& trace = Traces[Trace % MaxTraces];
+	const uint8 stageBit = 1 << (int32)Stage;
+	if (trace.ReachedStages & stageBit) return;
+	trace.ReachedStages |= stageBit;
+
+	// Slate timestamps can't be later than the frame that reads them, but clamp anyway
+	const double ms = FMath::Max(0.0, (Time - trace.ArrivalTime) * 1000.0);
+	FLighterLatencyHistogram& histogram = Histograms[(int32)trace.Source][(int32)Stage];
+	++histogram.Buckets[FMath::Min(FMath::FloorToInt(ms * BucketsPerMs), histogram.Buckets.Num() - 1)];
+	++histogram.Frames[(int32)FMath::Min<uint64>(GFrameCounter - trace.Frame, FLighterLatencyHistogram::MaxFrames - 1)];
+	++histogram.Count;
+	histogram.TotalMs += ms;
+	histogram.MaxMs = FMath::Max(histogram.MaxMs, ms);
+}
+
+void FLighterInputLatency::ReachOnPhysicsStep(const uint32 Trace)
+{
+	if (Trace != 0)
+		AwaitingPhysics.Add(Trace);
+}
+
+void FLighterInputLatency::OnPhysicsStep(const double Time)
+{
+	for (const uint32 trace : AwaitingPhysics)
+		Reach(trace, ELighterLatencyStage::Simulated, Time);
+	AwaitingPhysics.Reset();
+}
+
+void FLighterInputLatency::Reset()
+{
+	for (int32 source = 0; source < (int32)ELighterInputSource::Num; ++source)
+	{
+		NumTraces[source] = 0;
+		for (int32 stage = 0; stage < (int32)ELighterLatencyStage::Num; ++stage)
+		{
+			Histograms[source][stage] = FLighterLatencyHistogram();
+			Histograms[source][stage].Buckets.Init(0, MaxTraceMs * BucketsPerMs + 1);
+		}
+	}
+
+	// In-flight traces keep going, they just land in the fresh histograms
+	StartTime = FPlatformTime::Seconds();
+}
+
+bool FLighterInputLatency::SaveToCsv(const FString& Path) const
+{
+	FString summary = TEXT("Source,Stage,Traces,Count,AvgMs,P50Ms,P90Ms,P99Ms,MaxMs");
+	for (int32 frames = 0; frames < FLighterLatencyHistogram::MaxFrames; ++frames)
+		summary += FString::Printf(TEXT(",%dFrames%s"), frames, frames == FLighterLatencyHistogram::MaxFrames - 1 ? TEXT("+") : TEXT(""));
+	summary += TEXT("\n");
+
+	FString buckets = TEXT("Source,Stage,FromMs,ToMs,Count\n");
+
+	for (int32 source = 0; source < (int32)ELighterInputSource::Num; ++source)
+		for (int32 stage = 0; stage < (int32)ELighterLatencyStage::Num; ++stage)
+		{
+			const FLighterLatencyHistogram& histogram = Histograms[source][stage];
+			const TCHAR* sourceName = GetName((ELighterInputSource)source);
+			const TCHAR* stageName = GetName((ELighterLatencyStage)stage);
+
+			summary += FString::Printf(TEXT("%s,%s,%llu,%llu,%.2f,%.2f,%.2f,%.2f,%.2f"), sourceName, stageName, NumTraces[source], histogram.Count,
+				histogram.GetAverageMs(), histogram.GetPercentileMs(50.f), histogram.GetPercentileMs(90.f), histogram.GetPercentileMs(99.f), histogram.MaxMs);
+			for (const uint32 frames : histogram.Frames)
+				summary += FString::Printf(TEXT(",%u"), frames);
+			summary += TEXT("\n");
+
+			// Empty buckets left out, the last one is open ended
+			for (int32 bucket = 0; bucket < histogram.Buckets.Num(); ++bucket)
+				if (histogram.Buckets[bucket] > 0)
+					buckets += FString::Printf(TEXT("%s,%s,%.1f,%s,%u\n"), sourceName, stageName, bucket / (float)BucketsPerMs,
+						bucket == histogram.Buckets.Num() - 1 ? TEXT("") : *FString::Printf(TEXT("%.1f"), (bucket + 1) / (float)BucketsPerMs), histogram.Buckets[bucket]);
+		}
+
+	return FFileHelper::SaveStringToFile(summary, *Path)
+		&& FFileHelper::SaveStringToFile(buckets, *(FPaths::GetBaseFilename(Path, false) + TEXT("-Histogram.csv")));
+}
+
+const TCHAR* FLighterInputLatency::GetName(const ELighterInputSource Source)
+{
+	switch (Source)
+	{
+	case ELighterInputSource::MoveRight:	return TEXT("MoveRight");
+	case ELighterInputSource::Jump:			return TEXT("Jump");
+	case ELighterInputSource::Pointer:		return TEXT("Pointer");
+	case ELighterInputSource::Gamepad:		return TEXT("Gamepad");
+	default:								return TEXT("?");
+	}
+}
+
+const TCHAR* FLighterInputLatency::GetName(const ELighterLatencyStage Stage)
+{
+	switch (Stage)
+	{
+	case ELighterLatencyStage::Applied:		return TEXT("Applied");
+	case ELighterLatencyStage::Traced:		return TEXT("Traced");
+	case ELighterLatencyStage::Simulated:	return TEXT("Simulated");
+	case ELighterLatencyStage::Contact:		return TEXT("Contact");
+	default:								return TEXT("?");
+	}
+}
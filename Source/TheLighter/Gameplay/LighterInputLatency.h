@@ -0,0 +1,118 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Input => Effect latency, from the moment a sample arrives to the contact it causes
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+* Every input sample gets a TRACE the moment it arrives, the trace follows it through the frame
+*
+* 		Applied		=> The ball's Tick acted on it (Tracer target set, force added, jump velocity set)
+* 		Traced		=> The Tracer resolved a LitSet with the new aim					(Input => Tracer)
+* 		Simulated	=> First physics step that has it
+* 					   Aim			=> The first block it lit is solid in the scene		(Input => Collision)
+* 					   Movement		=> The force / velocity is in
+* 		Contact		=> The ball touched a block this aim made solid
+*
+* Each stage gets recorded ONCE per trace, in ms & frames since arrival, into its own histogram (Source x Stage)
+*
+* ARRIVAL
+* 		Pointer			=> The first mouse move behind this frame's aim (Slate preprocessor, see LighterPointerInput.h)
+* 		Keys & sticks	=> The last key / stick event mapped to the binding (Same preprocessor)
+* 		No Slate		=> When the binding fired (Misses whatever happened before the PlayerController ticked)
+*
+* A newer sample replaces the older one as the ball's aim => Every effect is charged to the NEWEST input behind it
+* Traces that nothing reached within MaxTraceMs are dropped
+*/
+
+enum class ELighterInputSource : uint8
+{
+	MoveRight,
+	Jump,
+	Pointer,
+	Gamepad,
+	Num
+};
+
+enum class ELighterLatencyStage : uint8
+{
+	Applied,
+	Traced,
+	Simulated,
+	Contact,
+	Num
+};
+
+
+struct FLighterLatencyHistogram
+{
+	static constexpr int32 MaxFrames = 8;
+
+	TArray<uint32> Buckets;							// BucketMs wide, everything past MaxTraceMs lands in the last one
+	uint32 Frames[MaxFrames] = {};					// Last one => That many or more
+	uint64 Count = 0;
+	double TotalMs = 0.0;
+	double MaxMs = 0.0;
+
+	float GetPercentileMs(const float Percentile) const;
+	float GetAverageMs() const { return Count ? (float)(TotalMs / Count) : 0.f; }
+};
+
+
+class FLighterInputLatency
+{
+public:
+	static constexpr int32 MaxTraces = 256;			// Ring => Enough for every source, every frame, for longer than MaxTraceMs
+	static constexpr int32 MaxTraceMs = 500;
+	static constexpr int32 BucketsPerMs = 2;
+
+	FLighterInputLatency();
+
+	// Lighter.InputLatency
+	static bool IsEnabled();
+
+	// 0 => Not tracing, every call below ignores it
+	uint32 Begin(const ELighterInputSource Source, const double ArrivalTime);
+
+	// Still in the ring & younger than MaxTraceMs
+	bool IsAlive(const uint32 Trace, const double Time) const;
+
+	// First time only
+	void Reach(const uint32 Trace, const ELighterLatencyStage Stage, const double Time);
+
+	// Simulated, at the next physics step
+	void ReachOnPhysicsStep(const uint32 Trace);
+	void OnPhysicsStep(const double Time);
+
+	FORCEINLINE const FLighterLatencyHistogram& GetHistogram(const ELighterInputSource Source, const ELighterLatencyStage Stage) const { return Histograms[(int32)Source][(int32)Stage]; }
+	FORCEINLINE uint64 GetNumTraces(const ELighterInputSource Source) const { return NumTraces[(int32)Source]; }
+	FORCEINLINE double GetStartTime() const { return StartTime; }
+
+	void Reset();
+
+	// Summary (One row per Source x Stage) & the raw buckets next to it (<Path>-Histogram.csv)
+	bool SaveToCsv(const FString& Path) const;
+
+	static const TCHAR* GetName(const ELighterInputSource Source);
+	static const TCHAR* GetName(const ELighterLatencyStage Stage);
+
+private:
+	struct FTrace
+	{
+		uint32 Id = 0;
+		ELighterInputSource Source = ELighterInputSource::MoveRight;
+		uint8 ReachedStages = 0;					// Bit per stage
+		uint64 Frame = 0;
+		double ArrivalTime = 0.0;
+	};
+
+	FTrace Traces[MaxTraces];
+	uint32 NextId = 1;
+	uint64 NumTraces[(int32)ELighterInputSource::Num] = {};
+	TArray<uint32> AwaitingPhysics;
+
+	FLighterLatencyHistogram Histograms[(int32)ELighterInputSource::Num][(int32)ELighterLatencyStage::Num];
+	double StartTime = 0.0;
+};
@@ -0,0 +1,154 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Recorded PlayerBall input, replayable headless
+
+#include "LighterInputRecording.h"
+#include "TheLighterBall.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+
+namespace
+{
+	const uint32 RecordingMagic = 0x4C524543;		// "LREC"
+	const uint32 RecordingVersion = 1;
+
+	enum EFrameFlags : uint8
+	{
+		Jump = 1 << 0,
+		PointerMoved = 1 << 1
+	};
+}
+
+
+
+////////////////////////////////////////////////////////////////////// SERIALIZATION
+#pragma region SERIALIZATION
+FArchive& operator<<(FArchive& Ar, FLighterInputFrame& Frame)
+{
+	// Pack the bools, the pointer only goes in when it's actually used
+	uint8 flags = (uint8)((Frame.bJump ? EFrameFlags::Jump : 0) | (Frame.bPointerMoved ? EFrameFlags::PointerMoved : 0));
+
+	Ar << Frame.DeltaSeconds;
+	Ar << Frame.MoveRight;
+	Ar << Frame.PointRight;
+	Ar << Frame.PointUp;
+	Ar << flags;
+
+	Frame.bJump = (flags & EFrameFlags::Jump) != 0;
+	Frame.bPointerMoved = (flags & EFrameFlags::PointerMoved) != 0;
+	if (Frame.bPointerMoved)
+		Ar << Frame.PointerLocation;
+
+	Ar << Frame.BallLocation;
+	Ar << Frame.LitSetHash;
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLighterInputRecording& Recording)
+{
+	Ar << Recording.MapName;
+	Ar << Recording.StartTransform;
+	Ar << Recording.StartLinearVelocity;
+	Ar << Recording.StartAngularVelocity;
+	Ar << Recording.StartTracerRotation;
+	Ar << Recording.StartTargetTracerRotation;
+	Ar << Recording.Frames;
+	return Ar;
+}
+
+bool FLighterInputRecording::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> bytes;
+	FMemoryWriter writer(bytes);
+
+	uint32 magic = RecordingMagic;
+	uint32 version = RecordingVersion;
+	writer << magic;
+	writer << version;
+	writer << const_cast<FLighterInputRecording&>(*this);
+
+	return FFileHelper::SaveArrayToFile(bytes, *Path);
+}
+
+bool FLighterInputRecording::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> bytes;
+	if (!FFileHelper::LoadFileToArray(bytes, *Path))
+		return false;
+
+	FMemoryReader reader(bytes);
+	uint32 magic = 0;
+	uint32 version = 0;
+	reader << magic;
+	reader << version;
+	if (magic != RecordingMagic || version != RecordingVersion)
+		return false;
+
+	reader << *this;
+	return !reader.IsError();
+}
+
+FString FLighterInputRecording::GetRecordingPath(const FString& Name)
+{
+	return FPaths::ProjectSavedDir() / TEXT("TheLighter") / TEXT("Recordings") / (Name + TEXT(".lrec"));
+}
+#pragma endregion SERIALIZATION
+////////////////////////////////////////////////////////////////////// SERIALIZATION
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// CONSOLE
+#pragma region CONSOLE
+static ATheLighterBall* GetPlayerBall(UWorld* World, FOutputDevice& Ar)
+{
+	const APlayerController* playerController = World ? World->GetFirstPlayerController() : nullptr;
+	ATheLighterBall* playerBall = playerController ? Cast<ATheLighterBall>(playerController->GetPawn()) : nullptr;
+	if (!playerBall)
+		Ar.Log(TEXT("No PlayerBall to record / replay"));
+	return playerBall;
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterRecordStartCommand(
+	TEXT("Lighter.Record.Start"),
+	TEXT("Starts recording the PlayerBall's input"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (ATheLighterBall* playerBall = GetPlayerBall(World, Ar))
+			playerBall->StartInputRecording();
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterRecordStopCommand(
+	TEXT("Lighter.Record.Stop"),
+	TEXT("Stops recording & saves it. Args: <Name>"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (ATheLighterBall* playerBall = GetPlayerBall(World, Ar))
+			playerBall->StopInputRecording(Args.Num() > 0 ? Args[0] : FDateTime::Now().ToString());
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterReplayCommand(
+	TEXT("Lighter.Replay"),
+	TEXT("Replays a recording into the PlayerBall as fast as possible. Args: <Name> [quit]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (Args.Num() < 1)
+		{
+			Ar.Log(TEXT("Usage: Lighter.Replay <Name> [quit]"));
+			return;
+		}
+
+		if (ATheLighterBall* playerBall = GetPlayerBall(World, Ar))
+			playerBall->StartInputReplay(Args[0], Args.Num() > 1 && Args[1] == TEXT("quit"));
+	}));
+#pragma endregion CONSOLE
+////////////////////////////////////////////////////////////////////// CONSOLE
@@ -0,0 +1,72 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Recorded PlayerBall input, replayable headless
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+* A play session boiled down to what ATheLighterBall reads every frame
+*
+* 		MoveRight / PointRight / PointUp	=> Axis values
+* 		Jump								=> Pressed this frame?
+* 		PointerLocation						=> Mouse deprojection result (Only on frames the mouse moved)
+* 		DeltaSeconds						=> Frame time, replayed as a FIXED timestep
+*
+* Every frame also stores the ball's location & a hash of the LitSet AFTER the frame ran
+* So a replay can tell exactly when (& if) it drifted from the original session
+*
+*
+* Usage
+* -----
+* Record	=> -LighterRecord=<Name>	(From BeginPlay to EndPlay)
+* 			   Lighter.Record.Start / Lighter.Record.Stop <Name>
+*
+* Replay	=> -LighterReplay=<Name> [-LighterReplayQuit]
+* 			   Lighter.Replay <Name> [quit]
+*
+* Headless on Linux:
+* 		UE4Editor-Cmd TheLighter.uproject <Map> -game -nullrhi -unattended -nosound -LighterReplay=<Name> -LighterReplayQuit
+*
+* Files live in Saved/TheLighter/Recordings/<Name>.lrec
+*/
+
+struct FLighterInputFrame
+{
+	float DeltaSeconds = 0.f;
+	float MoveRight = 0.f;
+	float PointRight = 0.f;
+	float PointUp = 0.f;
+	bool bJump = false;
+	bool bPointerMoved = false;
+	FVector PointerLocation = FVector::ZeroVector;
+
+	// Verification (State AFTER the frame)
+	FVector BallLocation = FVector::ZeroVector;
+	uint32 LitSetHash = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FLighterInputFrame& Frame);
+};
+
+
+class FLighterInputRecording
+{
+public:
+	// Where the session started
+	FString MapName;
+	FTransform StartTransform;
+	FVector StartLinearVelocity = FVector::ZeroVector;
+	FVector StartAngularVelocity = FVector::ZeroVector;
+	FRotator StartTracerRotation = FRotator::ZeroRotator;
+	FRotator StartTargetTracerRotation = FRotator::ZeroRotator;
+
+	TArray<FLighterInputFrame> Frames;
+
+	bool SaveToFile(const FString& Path) const;
+	bool LoadFromFile(const FString& Path);
+
+	static FString GetRecordingPath(const FString& Name);
+
+	friend FArchive& operator<<(FArchive& Ar, FLighterInputRecording& Recording);
+};
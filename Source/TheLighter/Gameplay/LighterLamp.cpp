@@ -0,0 +1,87 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Static light source that lights LighterBlocks on its own
+
+#include "LighterLamp.h"
+#include "TheLighter.h"
+#include "LighterBlockGrid.h"
+#include "LighterBlockSubsystem.h"
+#include "Components/SpotLightComponent.h"
+
+#pragma region CORE
+ALighterLamp::ALighterLamp()
+{
+	// Only ever does work when it moves
+	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	SpotLight = CreateDefaultSubobject<USpotLightComponent>(TEXT("SpotLight0"));
+	RootComponent = SpotLight;
+}
+#pragma endregion
+
+
+
+
+
+
+
+#pragma region EVENTS
+void ALighterLamp::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+		EmitterId = subsystem->RegisterEmitter();
+
+	SpotLight->TransformUpdated.AddUObject(this, &ALighterLamp::OnLampTransformUpdated);
+	RefreshCone();
+}
+
+void ALighterLamp::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	SpotLight->TransformUpdated.RemoveAll(this);
+
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+		subsystem->UnregisterEmitter(EmitterId);
+	EmitterId = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ALighterLamp::OnLampTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	RefreshCone();
+}
+#pragma endregion
+
+
+
+
+
+
+
+#pragma region LAMP
+void ALighterLamp::SetLampOn(const bool bOn)
+{
+	bLampOn = bOn;
+	SpotLight->SetVisibility(bOn);
+	RefreshCone();
+}
+
+void ALighterLamp::RefreshCone()
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem || EmitterId == INDEX_NONE) return;
+
+	if (!bLampOn)
+	{
+		subsystem->ClearEmitter(EmitterId);
+		return;
+	}
+
+	// Same cone the PlayerBall's Tracer builds, off the SpotLight
+	// An unchanged cone is a no-op on the subsystem's side
+	const FLighterCone cone(ToLighterPlane(SpotLight->GetComponentLocation()), ToLighterPlane(SpotLight->GetForwardVector()), SpotLight->OuterConeAngle - TraceAngleCorrection, TraceLength);
+	subsystem->SetEmitterCone(EmitterId, cone, bOccludedByBlocks ? ELighterEmitterQuery::Visibility : ELighterEmitterQuery::Cone);
+}
+#pragma endregion
@@ -0,0 +1,75 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Static light source that lights LighterBlocks on its own
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LighterLamp.generated.h"
+
+
+/*
+* A SpotLight placed in the level that makes LighterBlocks solid, same as the PlayerBall's Tracer
+*
+* 1. Registers ONE emitter with the LighterBlockSubsystem on BeginPlay
+* 2. Hands its cone in once, then again only when it's moved / rotated
+* 3. The subsystem caches the result => A lamp that doesn't move costs nothing per frame
+*
+* NOTE: Lamps pointing at the same area share one grid query in the batched pass
+*/
+
+UCLASS(config=Game)
+class ALighterLamp : public AActor
+{
+	GENERATED_BODY()
+
+#pragma region CORE
+public:
+	ALighterLamp();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+		class USpotLightComponent* SpotLight;
+#pragma endregion
+
+
+
+
+#pragma region LAMP
+public:
+	// How far the lamp reaches
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lamp", meta = (ClampMin = "0.0"))
+		float TraceLength = 2000.f;
+
+	// Shrinks the cone relative to the SpotLight's OuterConeAngle
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lamp", meta = (ClampMin = "0.0"))
+		float TraceAngleCorrection = 0.f;
+
+	// True => Only the blocks the light actually reaches (Visibility), False => Everything in the cone
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lamp")
+		bool bOccludedByBlocks = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Lamp")
+		bool bLampOn = true;
+
+	UFUNCTION(BlueprintCallable, Category = "Lamp")
+		void SetLampOn(const bool bOn);
+
+	// Push the current cone to the subsystem (Automatic when the lamp moves)
+	UFUNCTION(BlueprintCallable, Category = "Lamp")
+		void RefreshCone();
+
+private:
+	void OnLampTransformUpdated(class USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	int32 EmitterId = INDEX_NONE;
+#pragma endregion
+
+
+
+
+#pragma region EVENTS
+public:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+#pragma endregion
+};
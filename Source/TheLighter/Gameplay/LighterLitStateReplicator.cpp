@@ -0,0 +1,359 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Lit state of every LighterBlock, bit-packed & delta-replicated per connection
+
+#include "LighterLitStateReplicator.h"
+#include "TheLighter.h"
+#include "Block.h"
+#include "BlockField.h"
+#include "LighterBlockSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Net/UnrealNetwork.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+
+////////////////////////////////////////////////////////////////////// LIT BITS
+#pragma region LIT BITS
+void FLighterLitNetStats::Reset()
+{
+	*this = FLighterLitNetStats();
+	StartTime = FPlatformTime::Seconds();
+}
+
+FLighterLitNetStats& FLighterLitBits::GetStats()
+{
+	static FLighterLitNetStats stats;
+	return stats;
+}
+
+void FLighterLitBits::SetNum(const int32 InNumBits)
+{
+	NumBits = InNumBits;
+	Words.Reset();
+	Words.SetNumZeroed((InNumBits + 31) / 32);
+}
+
+
+// What one connection last got (The engine keeps one per connection & per unacked packet)
+class FLighterLitBitsBaseState : public INetDeltaBaseState
+{
+public:
+	TArray<uint32> Words;
+	int32 NumBits = 0;
+
+	virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+	{
+		const FLighterLitBitsBaseState* other = static_cast<const FLighterLitBitsBaseState*>(OtherState);
+		return NumBits == other->NumBits && Words == other->Words;
+	}
+};
+
+
+/*
+* WIRE FORMAT
+* 		bFull			1 bit		=> No base state (Or the net order changed size), every non-zero word follows
+* 		NumBits			Packed
+* 		NumChanged		Packed
+* 		NumChanged x	Packed gap to the previous changed word + the word itself (32 bits)
+*
+* A puzzle lighting up a handful of blocks => A few bytes, however many blocks the level has
+*/
+
+bool FLighterLitBits::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	FLighterLitNetStats& stats = GetStats();
+
+	if (DeltaParms.Writer)
+	{
+		LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterNetSerializeLitBits);
+		const uint32 startCycles = FPlatformTime::Cycles();
+		const FLighterLitBitsBaseState* oldState = static_cast<const FLighterLitBitsBaseState*>(DeltaParms.OldState);
+		const bool bFull = !oldState || oldState->NumBits != NumBits;
+
+		// Counted first, so nothing gets allocated when the connection is already up to date
+		uint32 numChanged = 0;
+		for (int32 i = 0; i < Words.Num(); ++i)
+			if (Words[i] != (bFull ? 0u : oldState->Words[i]))
+				++numChanged;
+
+		if (!bFull && numChanged == 0)
+		{
+			stats.SerializeCycles += FPlatformTime::Cycles() - startCycles;
+			return false;
+		}
+
+		FLighterLitBitsBaseState* newState = new FLighterLitBitsBaseState();
+		newState->Words = Words;
+		newState->NumBits = NumBits;
+		*DeltaParms.NewState = MakeShareable(newState);
+
+		FBitWriter& writer = *DeltaParms.Writer;
+		const int64 startBits = writer.GetNumBits();
+
+		writer.WriteBit(bFull ? 1 : 0);
+		uint32 numBits = NumBits;
+		writer.SerializeIntPacked(numBits);
+		writer.SerializeIntPacked(numChanged);
+
+		int32 previous = 0;
+		for (int32 i = 0; i < Words.Num(); ++i)
+		{
+			if (Words[i] == (bFull ? 0u : oldState->Words[i])) continue;
+
+			uint32 gap = i - previous;
+			uint32 word = Words[i];
+			writer.SerializeIntPacked(gap);
+			writer << word;
+			previous = i;
+		}
+
+		stats.BitsSent += writer.GetNumBits() - startBits;
+		++stats.Updates;
+		if (bFull)
+			++stats.FullUpdates;
+		stats.SerializeCycles += FPlatformTime::Cycles() - startCycles;
+		return true;
+	}
+
+	if (DeltaParms.Reader)
+	{
+		FBitReader& reader = *DeltaParms.Reader;
+		const int64 startBits = reader.GetPosBits();
+
+		const bool bFull = reader.ReadBit() != 0;
+		uint32 numBits = 0, numChanged = 0;
+		reader.SerializeIntPacked(numBits);
+		reader.SerializeIntPacked(numChanged);
+
+		// A level with more than 16M blocks is a corrupt packet
+		if (reader.IsError() || numBits > (1u << 24) || numChanged > (numBits + 31) / 32)
+		{
+			reader.SetError();
+			return false;
+		}
+
+		if (bFull || (int32)numBits != NumBits)
+			SetNum(numBits);
+
+		uint32 index = 0;
+		for (uint32 i = 0; i < numChanged; ++i)
+		{
+			uint32 gap = 0, word = 0;
+			reader.SerializeIntPacked(gap);
+			reader << word;
+			index += gap;
+
+			if (reader.IsError() || !Words.IsValidIndex(index))
+			{
+				reader.SetError();
+				return false;
+			}
+			Words[index] = word;
+		}
+
+		stats.BitsReceived += reader.GetPosBits() - startBits;
+		++stats.Received;
+		++ReceivedVersion;
+		return true;
+	}
+
+	// No object references in here => Nothing to map
+	return false;
+}
+#pragma endregion LIT BITS
+////////////////////////////////////////////////////////////////////// LIT BITS
+
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// CORE
+#pragma region CORE
+ALighterLitStateReplicator::ALighterLitStateReplicator()
+{
+	// Clients apply what came in once per frame, the server packs in PreReplication
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	NetUpdateFrequency = 30.f;
+	MinNetUpdateFrequency = 10.f;
+}
+
+void ALighterLitStateReplicator::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!HasAuthority())
+		if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+			EmitterId = subsystem->RegisterEmitter();
+
+	FLighterLitBits::GetStats().Reset();
+}
+
+void ALighterLitStateReplicator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+		subsystem->UnregisterEmitter(EmitterId);
+	EmitterId = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ALighterLitStateReplicator::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	if (HasAuthority()) return;
+
+	// New bits, or the same bits over a net order that just changed
+	const bool bNetOrderChanged = UpdateNetOrder();
+	if (AppliedVersion != LitBits.ReceivedVersion || bNetOrderChanged)
+		ApplyLitBits();
+}
+
+void ALighterLitStateReplicator::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+	PackLitBits();
+}
+
+void ALighterLitStateReplicator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(ALighterLitStateReplicator, LitBits);
+	DOREPLIFETIME(ALighterLitStateReplicator, NetOrderHash);
+}
+#pragma endregion CORE
+////////////////////////////////////////////////////////////////////// CORE
+
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// LIT STATE
+#pragma region LIT STATE
+// Level-loaded actors have the same name on every end (Minus the PIE prefix)
+// Anything spawned at runtime doesn't, so it never gets a bit
+
+static AActor* GetNetStableBlockActor(const FLighterBlockSlot& Slot)
+{
+	AActor* actor = Slot.Block ? (AActor*)Slot.Block : (AActor*)Slot.Field;
+	return actor && actor->IsNetStartupActor() ? actor : nullptr;
+}
+
+bool ALighterLitStateReplicator::UpdateNetOrder()
+{
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem || subsystem->GetRegistryVersion() == NetOrderRegistryVersion) return false;
+	NetOrderRegistryVersion = subsystem->GetRegistryVersion();
+
+	// Runtime blocks come & go all the time (Runner pool), only a change in the stable ones rebuilds
+	int32 numStable = 0;
+	for (int32 blockIndex = 0; blockIndex < subsystem->GetNumSlots(); ++blockIndex)
+		if (const FLighterBlockSlot* slot = subsystem->GetSlot(blockIndex))
+			if (GetNetStableBlockActor(*slot))
+				++numStable;
+
+	bool bChanged = numStable != NetOrder.Num();
+	for (int32 i = 0; i < NetOrder.Num() && !bChanged; ++i)
+	{
+		const FLighterBlockSlot* slot = subsystem->GetSlot(NetOrder[i]);
+		bChanged = !slot || !GetNetStableBlockActor(*slot);
+	}
+	if (!bChanged) return false;
+
+	LIGHTER_LLM_SCOPE();
+	struct FNetKey
+	{
+		FString Name;
+		int32 InstanceIndex;
+		int32 BlockIndex;
+	};
+
+	TArray<FNetKey> keys;
+	keys.Reserve(numStable);
+	for (int32 blockIndex = 0; blockIndex < subsystem->GetNumSlots(); ++blockIndex)
+		if (const FLighterBlockSlot* slot = subsystem->GetSlot(blockIndex))
+			if (const AActor* actor = GetNetStableBlockActor(*slot))
+				keys.Add({ UWorld::RemovePIEPrefix(actor->GetPathName()), slot->InstanceIndex, blockIndex });
+
+	keys.Sort([](const FNetKey& A, const FNetKey& B)
+	{
+		const int32 compare = A.Name.Compare(B.Name);
+		return compare != 0 ? compare < 0 : A.InstanceIndex < B.InstanceIndex;
+	});
+
+	NetOrder.Reset(keys.Num());
+	LocalNetOrderHash = keys.Num();
+	for (const FNetKey& key : keys)
+	{
+		NetOrder.Add(key.BlockIndex);
+		LocalNetOrderHash = HashCombine(LocalNetOrderHash, HashCombine(FCrc::StrCrc32(*key.Name), GetTypeHash(key.InstanceIndex)));
+	}
+
+	if (HasAuthority())
+		NetOrderHash = LocalNetOrderHash;
+	bWarnedMismatch = false;
+
+	UE_LOG(LogTheLighter, Log, TEXT("LighterLitStateReplicator => %d blocks in net order (Hash %08x)"), NetOrder.Num(), LocalNetOrderHash);
+	return true;
+}
+
+void ALighterLitStateReplicator::PackLitBits()
+{
+	if (!HasAuthority()) return;
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterNetPackLitBits);
+	const uint32 startCycles = FPlatformTime::Cycles();
+
+	UpdateNetOrder();
+	if (LitBits.NumBits != NetOrder.Num())
+		LitBits.SetNum(NetOrder.Num());
+
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	for (int32 i = 0; i < NetOrder.Num(); ++i)
+		LitBits.Set(i, subsystem->IsBlockLit(NetOrder[i]));
+
+	FLighterLitNetStats& stats = FLighterLitBits::GetStats();
+	stats.PackCycles += FPlatformTime::Cycles() - startCycles;
+	++stats.Packs;
+}
+
+void ALighterLitStateReplicator::ApplyLitBits()
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem || EmitterId == INDEX_NONE) return;
+	AppliedVersion = LitBits.ReceivedVersion;
+
+	// A different level on this end => The bits would light the wrong blocks
+	if (!DoesNetOrderMatch() || LitBits.NumBits != NetOrder.Num())
+	{
+		if (!bWarnedMismatch && LitBits.ReceivedVersion > 0)
+			UE_LOG(LogTheLighter, Warning, TEXT("LighterLitStateReplicator => Net order doesn't match the server (%d blocks here, %d there), lit state not applied"), NetOrder.Num(), LitBits.NumBits);
+		bWarnedMismatch = true;
+		return;
+	}
+
+	// Only the set bits, a word at a time
+	RemoteHits.Reset();
+	for (int32 word = 0; word < LitBits.Words.Num(); ++word)
+		for (uint32 bits = LitBits.Words[word]; bits != 0; bits &= bits - 1)
+		{
+			const int32 netIndex = word * 32 + FMath::CountTrailingZeros(bits);
+			if (netIndex < NetOrder.Num())
+				RemoteHits.Add(NetOrder[netIndex]);
+		}
+
+	// Diffed against what the server lit last time, only the changes toggle anything
+	subsystem->SetEmitterHits(EmitterId, RemoteHits);
+}
+#pragma endregion LIT STATE
+////////////////////////////////////////////////////////////////////// LIT STATE
@@ -0,0 +1,140 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Lit state of every LighterBlock, bit-packed & delta-replicated per connection
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Engine/NetSerialization.h"
+#include "LighterBlockSet.h"
+#include "LighterLitStateReplicator.generated.h"
+
+
+/*
+* Co-op => Every player has to see (And collide with) the same lit blocks
+* Replicating every ABlock would mean one actor channel per block, so ONE always-relevant actor carries them all
+*
+* 		NET ORDER	=> The blocks that exist on both ends (Loaded with the level), sorted by name & instance
+* 					   A block's place in there is its bit, so server & clients agree without sending any ids
+* 		LIT BITS	=> 1 bit per block in net order
+* 					   Collision follows the lit count, so that's everything a client needs
+* 		DELTA		=> Per connection, only the 32 bit words that changed since that connection's base state
+* 					   The engine keeps the base state per connection & falls back to the last acked one on packet loss
+*
+* Client side, the bits become one more EMITTER in the LighterBlockSubsystem
+* The local ball still lights blocks right away, the server's state is added on top (Lit counts)
+*
+* NOTE: Blocks spawned at runtime (LighterRunnerGameMode's pool) have no stable name & stay local
+*/
+
+
+// Everything the lit state costs on the wire & on the server (Lighter.Net.Stats)
+struct FLighterLitNetStats
+{
+	uint64 BitsSent = 0;
+	uint64 BitsReceived = 0;
+	uint32 Updates = 0;				// Deltas written (One per connection that needed one)
+	uint32 FullUpdates = 0;			// Of those, sent without a base state
+	uint32 Received = 0;
+	uint32 Packs = 0;
+	uint64 PackCycles = 0;			// Server => Lit counts into bits (Once per net update)
+	uint64 SerializeCycles = 0;		// Server => Writing the deltas (Once per connection)
+	double StartTime = 0.0;
+
+	void Reset();
+};
+
+
+// The packed bits + their delta serializer
+USTRUCT()
+struct FLighterLitBits
+{
+	GENERATED_BODY()
+
+	// Bit i => Block i in net order is lit
+	TArray<uint32> Words;
+	int32 NumBits = 0;
+
+	// Bumped every time a client reads an update
+	uint32 ReceivedVersion = 0;
+
+	// Resizes & clears
+	void SetNum(const int32 InNumBits);
+
+	FORCEINLINE bool Get(const int32 Index) const { return (Words[Index >> 5] >> (Index & 31)) & 1u; }
+	FORCEINLINE void Set(const int32 Index, const bool bLit)
+	{
+		const uint32 mask = 1u << (Index & 31);
+		Words[Index >> 5] = bLit ? (Words[Index >> 5] | mask) : (Words[Index >> 5] & ~mask);
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+	static FLighterLitNetStats& GetStats();
+};
+
+template<>
+struct TStructOpsTypeTraits<FLighterLitBits> : public TStructOpsTypeTraitsBase2<FLighterLitBits>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+
+// Spawned by the game mode in any networked game (See ATheLighterGameMode::BeginPlay)
+UCLASS(NotPlaceable)
+class ALighterLitStateReplicator : public AInfo
+{
+	GENERATED_BODY()
+
+#pragma region CORE
+public:
+	ALighterLitStateReplicator();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+#pragma endregion
+
+
+
+
+#pragma region LIT STATE
+public:
+	FORCEINLINE int32 GetNumNetBlocks() const { return NetOrder.Num(); }
+	FORCEINLINE const FLighterLitBits& GetLitBits() const { return LitBits; }
+	FORCEINLINE bool DoesNetOrderMatch() const { return NetOrderHash == LocalNetOrderHash; }
+
+private:
+	// Only when the registry gained / lost a block that exists on both ends (True => Rebuilt)
+	bool UpdateNetOrder();
+
+	// Server => Lit counts into bits
+	void PackLitBits();
+
+	// Client => Bits into our emitter
+	void ApplyLitBits();
+
+	UPROPERTY(Replicated)
+		FLighterLitBits LitBits;
+
+	// The server's net order, hashed => A client whose level doesn't match says so
+	UPROPERTY(Replicated)
+		uint32 NetOrderHash = 0;
+
+	// Net index => BlockIndex
+	TArray<int32> NetOrder;
+	uint32 LocalNetOrderHash = 0;
+	uint32 NetOrderRegistryVersion = 0;
+
+	// Client only
+	int32 EmitterId = INDEX_NONE;
+	uint32 AppliedVersion = 0;
+	FLighterBlockSet RemoteHits;
+	bool bWarnedMismatch = false;
+#pragma endregion
+};
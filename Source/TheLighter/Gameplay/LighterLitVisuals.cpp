@@ -0,0 +1,17 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Lit / unlit fades of the LighterBlocks, computed on the GPU
+
+#include "LighterLitVisuals.h"
+#include "HAL/IConsoleManager.h"
+
+
+static TAutoConsoleVariable<float> CVarLighterLitFadeSeconds(
+	TEXT("Lighter.LitFadeSeconds"),
+	0.25f,
+	TEXT("Seconds a LighterBlock takes to fade in when lit & out when unlit (Written into its custom data)"),
+	ECVF_Default);
+
+float LighterLitVisuals::GetFadeSeconds()
+{
+	return FMath::Max(0.f, CVarLighterLitFadeSeconds.GetValueOnGameThread());
+}
@@ -0,0 +1,49 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Lit / unlit fades of the LighterBlocks, computed on the GPU
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+
+/*
+* Fading a block with a dynamic material instance + timeline means a parameter update & a render state dirty
+* on EVERY block, EVERY frame of the fade
+*
+* Instead, a lit state change writes ONE fade description into the block's custom data
+* 		ABlock					=> Custom primitive data
+* 		ABlockField instance	=> Per-instance custom data (All the changes of a frame, ONE render state dirty per field)
+*
+* 		[0] From		=> Lit factor when the fade started (0 => Unlit, 1 => Lit)
+* 		[1] To			=> Lit factor it's heading to
+* 		[2] StartTime	=> World time of the change (Same clock as the material's Time node)
+* 		[3] Duration	=> Seconds (Lighter.LitFadeSeconds)
+*
+* Material side (CustomPrimitiveData / PerInstanceCustomData 0..3):
+* 		LitFactor = lerp(From, To, saturate((Time - StartTime) / Duration))
+*
+* NOTE: After the write there's NO CPU work until the next state change
+* NOTE: A change mid-fade starts from wherever the fade had got to, so it never pops
+*/
+
+namespace LighterLitVisuals
+{
+	enum ECustomData : int32
+	{
+		From = 0,
+		To,
+		StartTime,
+		Duration,
+		Num
+	};
+
+	// Lighter.LitFadeSeconds
+	float GetFadeSeconds();
+
+	// What the material shows at Time (Same formula)
+	FORCEINLINE float Evaluate(const FVector4& Fade, const float Time)
+	{
+		const float alpha = Fade.W > 0.f ? FMath::Clamp((Time - Fade.Z) / Fade.W, 0.f, 1.f) : 1.f;
+		return FMath::Lerp(Fade.X, Fade.Y, alpha);
+	}
+}
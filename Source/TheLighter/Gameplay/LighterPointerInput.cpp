@@ -0,0 +1,38 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Latest mouse move as it arrives, not once the frame gets to it
+
+#include "LighterPointerInput.h"
+#include "Input/Events.h"
+#include "HAL/PlatformTime.h"
+
+
+bool FLighterPointerInput::HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
+{
+	// Anything in between gets aimed past anyway => Only the latest one is kept
+	LatestSample.ScreenPosition = MouseEvent.GetScreenSpacePosition();
+	LatestSample.Timestamp = FPlatformTime::Seconds();
+	if (NumSamples++ == 0)
+		FirstSampleTime = LatestSample.Timestamp;
+
+	return false;
+}
+
+bool FLighterPointerInput::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+{
+	// Held keys repeat, only the press is a new sample
+	if (!InKeyEvent.IsRepeat())
+		KeyTimes.Add(InKeyEvent.GetKey(), FPlatformTime::Seconds());
+	return false;
+}
+
+bool FLighterPointerInput::HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
+{
+	KeyTimes.Add(InKeyEvent.GetKey(), FPlatformTime::Seconds());
+	return false;
+}
+
+bool FLighterPointerInput::HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent)
+{
+	KeyTimes.Add(InAnalogInputEvent.GetKey(), FPlatformTime::Seconds());
+	return false;
+}
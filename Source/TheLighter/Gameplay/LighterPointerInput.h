@@ -0,0 +1,57 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Latest mouse move as it arrives, not once the frame gets to it
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Framework/Application/IInputProcessor.h"
+#include "InputCoreTypes.h"
+
+
+/*
+* GetInputMouseDelta() & DeprojectMousePositionToWorld() only see the cursor ONCE per frame
+* And only after the frame's input has been processed
+*
+* This sits in front of Slate & keeps the LATEST mouse move as it arrives
+* 		ScreenPosition	=> Desktop space (Turned into viewport pixels when consumed)
+* 		Timestamp		=> FPlatformTime::Seconds() when the move came in
+* Plus when the FIRST move since the last reset came in (Input latency is measured from there)
+*
+* Only the latest position gets aimed at, so it's projected once per frame however fast the mouse reports
+*
+* Keys & analog sticks only get their LAST event's time per key (When the bindings' values came in, see LighterInputLatency.h)
+*
+* NOTE: Never consumes the event, the rest of the game sees the mouse as usual
+*/
+
+struct FLighterPointerSample
+{
+	FVector2D ScreenPosition = FVector2D::ZeroVector;
+	double Timestamp = 0.0;
+};
+
+
+class FLighterPointerInput : public IInputProcessor
+{
+public:
+	virtual void Tick(const float DeltaTime, FSlateApplication& SlateApp, TSharedRef<ICursor> Cursor) override {}
+	virtual bool HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent) override;
+	virtual bool HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
+	virtual bool HandleKeyUpEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent) override;
+	virtual bool HandleAnalogInputEvent(FSlateApplication& SlateApp, const FAnalogInputEvent& InAnalogInputEvent) override;
+
+	// Moves since the last reset, the latest one & when the first one came in
+	FORCEINLINE int32 GetNumSamples() const { return NumSamples; }
+	FORCEINLINE const FLighterPointerSample& GetLatestSample() const { return LatestSample; }
+	FORCEINLINE double GetFirstSampleTime() const { return FirstSampleTime; }
+	FORCEINLINE void ResetSamples() { NumSamples = 0; }
+
+	// FPlatformTime::Seconds() of the key's last event, 0 if it never had one
+	FORCEINLINE double GetKeyTime(const FKey& Key) const { const double* time = KeyTimes.Find(Key); return time ? *time : 0.0; }
+
+private:
+	FLighterPointerSample LatestSample;
+	double FirstSampleTime = 0.0;
+	int32 NumSamples = 0;
+	TMap<FKey, double> KeyTimes;
+};
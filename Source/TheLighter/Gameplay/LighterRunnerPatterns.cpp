@@ -0,0 +1,86 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Seeded LighterBlock layouts for the Runner
+
+#include "LighterRunnerPatterns.h"
+
+
+ELighterRunnerPattern LighterRunnerPatterns::Generate(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout)
+{
+	const ELighterRunnerPattern pattern = (ELighterRunnerPattern)Random.RandRange(0, (int32)ELighterRunnerPattern::Num - 1);
+	switch (pattern)
+	{
+	case ELighterRunnerPattern::Stairs:			GenerateStairs(Random, Start, Spacing, MinZ, MaxZ, OutLayout); break;
+	case ELighterRunnerPattern::BoosterChain:	GenerateBoosterChain(Random, Start, Spacing, MinZ, MaxZ, OutLayout); break;
+	default:									GenerateGrid(Random, Start, Spacing, MinZ, MaxZ, OutLayout); break;
+	}
+	return pattern;
+}
+
+void LighterRunnerPatterns::GenerateStairs(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout)
+{
+	const int32 numSteps = Random.RandRange(4, 8);
+	const float run = Spacing * Random.RandRange(2, 3);
+
+	// Climb unless that would leave the band, then drop
+	float rise = Spacing * (Random.RandBool() ? 1.f : -1.f);
+	if (Start.Y + rise * numSteps > MaxZ || Start.Y + rise * numSteps < MinZ)
+		rise = -rise;
+
+	FVector2D step = Start;
+	for (int32 i = 0; i < numSteps; ++i)
+	{
+		step.Y = FMath::Clamp(step.Y, MinZ, MaxZ);
+		OutLayout.Blocks.Add(step);
+		step += FVector2D(run, rise);
+	}
+
+	OutLayout.EndY = step.X;
+	OutLayout.EndZ = FMath::Clamp(step.Y - rise, MinZ, MaxZ);
+}
+
+void LighterRunnerPatterns::GenerateBoosterChain(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout)
+{
+	const int32 length = Random.RandRange(6, 12);
+
+	// Packed just past touching, so the ball's exits chain up
+	const float pitch = Spacing * 1.05f;
+	const float z = FMath::Clamp(Start.Y + Spacing * Random.RandRange(-1, 1), MinZ, MaxZ);
+
+	for (int32 i = 0; i < length; ++i)
+		OutLayout.Blocks.Add(FVector2D(Start.X + i * pitch, z));
+
+	OutLayout.EndY = Start.X + length * pitch;
+	OutLayout.EndZ = z;
+}
+
+void LighterRunnerPatterns::GenerateGrid(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout)
+{
+	const int32 columns = Random.RandRange(3, 6);
+	const int32 rows = Random.RandRange(2, 4);
+	const float pitch = Spacing * 2.f;
+
+	// Bottom row sits where the last pattern left off, as long as the whole grid fits
+	const float bottom = FMath::Clamp(Start.Y, MinZ, FMath::Max(MinZ, MaxZ - (rows - 1) * pitch));
+
+	for (int32 column = 0; column < columns; ++column)
+		for (int32 row = 0; row < rows; ++row)
+		{
+			// About a quarter knocked out, so there's always a way through
+			if (Random.FRand() < 0.25f) continue;
+			OutLayout.Blocks.Add(FVector2D(Start.X + column * pitch, bottom + row * pitch));
+		}
+
+	OutLayout.EndY = Start.X + columns * pitch;
+	OutLayout.EndZ = bottom;
+}
+
+const TCHAR* LighterRunnerPatterns::GetName(const ELighterRunnerPattern Pattern)
+{
+	switch (Pattern)
+	{
+	case ELighterRunnerPattern::Stairs:			return TEXT("Stairs");
+	case ELighterRunnerPattern::BoosterChain:	return TEXT("BoosterChain");
+	case ELighterRunnerPattern::Grid:			return TEXT("Grid");
+	default:									return TEXT("None");
+	}
+}
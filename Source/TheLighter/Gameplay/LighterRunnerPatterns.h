@@ -0,0 +1,53 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Seeded LighterBlock layouts for the Runner
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+
+/*
+* Every pattern is laid out on the YZ plane, starting at Start & running towards +Y
+*
+* 		Stairs			=> Blocks climbing (Or dropping) one step at a time
+* 		BoosterChain	=> A row of blocks packed close together (Chained ExitImpulses)
+* 		Grid			=> A 2D block of blocks with a few holes knocked out
+*
+* Same seed => Same run, block for block
+*
+* NOTE: Only the FRandomStream is read, so the generator is pure & works without a world
+*/
+
+enum class ELighterRunnerPattern : uint8
+{
+	Stairs,
+	BoosterChain,
+	Grid,
+	Num
+};
+
+namespace LighterRunnerPatterns
+{
+	struct FLayout
+	{
+		// Block centers (Y, Z)
+		TArray<FVector2D> Blocks;
+
+		// Where the next pattern picks up
+		float EndY = 0.f;
+		float EndZ = 0.f;
+
+		void Reset() { Blocks.Reset(); }
+	};
+
+	// Random pattern type & layout, Z kept inside [MinZ, MaxZ] (Returns the type it picked)
+	ELighterRunnerPattern Generate(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout);
+
+	// One specific pattern
+	void GenerateStairs(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout);
+	void GenerateBoosterChain(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout);
+	void GenerateGrid(FRandomStream& Random, const FVector2D& Start, const float Spacing, const float MinZ, const float MaxZ, FLayout& OutLayout);
+
+	const TCHAR* GetName(const ELighterRunnerPattern Pattern);
+}
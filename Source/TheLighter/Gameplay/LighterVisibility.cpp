@@ -0,0 +1,196 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Exact 2D visibility of the LighterBlocks inside the SpotLight's cone
+
+#include "LighterVisibility.h"
+
+
+// Slab test => Distance to where the ray enters the box
+static bool RayEntersBox(const FVector2D& Origin, const FVector2D& Direction, const FBox2D& Box, float& OutDistance)
+{
+	float tMin = 0.f;
+	float tMax = BIG_NUMBER;
+
+	for (int32 axis = 0; axis < 2; ++axis)
+	{
+		const float origin = Origin[axis];
+		const float direction = Direction[axis];
+		const float boxMin = Box.Min[axis];
+		const float boxMax = Box.Max[axis];
+
+		if (FMath::IsNearlyZero(direction))
+		{
+			if (origin < boxMin || origin > boxMax)
+				return false;
+			continue;
+		}
+
+		float t0 = (boxMin - origin) / direction;
+		float t1 = (boxMax - origin) / direction;
+		if (t0 > t1)
+			Swap(t0, t1);
+
+		tMin = FMath::Max(tMin, t0);
+		tMax = FMath::Min(tMax, t1);
+		if (tMin > tMax)
+			return false;
+	}
+
+	OutDistance = tMin;
+	return true;
+}
+
+
+
+void FLighterVisibility::AddInterval(const int32 Box, const float Low, const float High, const float HalfAngle)
+{
+	// The interval might sit a full turn off the cone's [-HalfAngle, HalfAngle]
+	for (const float shift : { -2.f * PI, 0.f, 2.f * PI })
+	{
+		const float low = FMath::Max(Low + shift, -HalfAngle);
+		const float high = FMath::Min(High + shift, HalfAngle);
+		if (low < high)
+		{
+			Events.Add({ low, Box, true });
+			Events.Add({ high, Box, false });
+		}
+	}
+}
+
+void FLighterVisibility::Compute(const FLighterCone& Cone, TArrayView<const FBox2D> Boxes, TArray<int32>& OutVisible, TArray<FVector2D>* OutPolygon)
+{
+	Events.Reset();
+	Active.Reset();
+	// Reset + Add keeps the capacity (Init would reallocate whenever the candidate count changes)
+	Visible.Reset();
+	Visible.Add(false, Boxes.Num());
+	if (OutPolygon)
+		OutPolygon->Reset();
+
+	if (Cone.Range <= 0.f)
+		return;
+
+	const float baseAngle = FMath::Atan2(Cone.Direction.Y, Cone.Direction.X);
+
+
+
+	// 1. Angular interval of every box (Relative to the cone's direction)
+	for (int32 i = 0; i < Boxes.Num(); ++i)
+	{
+		const FBox2D& box = Boxes[i];
+		if (!box.bIsValid) continue;
+
+		if (box.IsInside(Cone.Apex))
+		{
+			Visible[i] = true;
+			continue;
+		}
+
+		// Corners relative to the direction of the box's center
+		// The apex is outside, so they all sit within half a turn of it => No wrap-around
+		const FVector2D toCenter = box.GetCenter() - Cone.Apex;
+		const float centerAngle = FMath::Atan2(toCenter.Y, toCenter.X);
+		const FVector2D corners[4] = { box.Min, FVector2D(box.Max.X, box.Min.Y), box.Max, FVector2D(box.Min.X, box.Max.Y) };
+
+		float low = BIG_NUMBER;
+		float high = -BIG_NUMBER;
+		for (const FVector2D& corner : corners)
+		{
+			const FVector2D toCorner = corner - Cone.Apex;
+			const float angle = FMath::UnwindRadians(FMath::Atan2(toCorner.Y, toCorner.X) - centerAngle);
+			low = FMath::Min(low, angle);
+			high = FMath::Max(high, angle);
+		}
+
+		const float offset = FMath::UnwindRadians(centerAngle - baseAngle);
+		AddInterval(i, low + offset, high + offset, Cone.HalfAngle);
+	}
+
+
+
+	// 2. Elementary intervals
+	Events.Sort();
+
+	auto addPolygonPoint = [&Cone, OutPolygon](const float Angle, const float Distance)
+	{
+		OutPolygon->Add(Cone.Apex + RotateVector2D(Cone.Direction, Angle) * FMath::Min(Distance, Cone.Range));
+	};
+
+	auto processInterval = [&](const float Low, const float High)
+	{
+		// 4. Front-most box along the middle ray
+		const float middle = (Low + High) * 0.5f;
+		const FVector2D middleDirection = RotateVector2D(Cone.Direction, middle);
+
+		int32 front = INDEX_NONE;
+		float frontDistance = BIG_NUMBER;
+		for (const int32 box : Active)
+		{
+			float distance;
+			if (RayEntersBox(Cone.Apex, middleDirection, Boxes[box], distance) && distance < frontDistance)
+			{
+				front = box;
+				frontDistance = distance;
+			}
+		}
+
+		if (front != INDEX_NONE && !Visible[front])
+		{
+			// Exact => Does the light reach it ANYWHERE in this interval
+			FLighterCone subCone;
+			subCone.Apex = Cone.Apex;
+			subCone.Direction = middleDirection;
+			subCone.HalfAngle = (High - Low) * 0.5f;
+			subCone.Range = Cone.Range;
+			if (subCone.Intersects(Boxes[front]))
+				Visible[front] = true;
+		}
+
+		if (!OutPolygon)
+			return;
+
+		// Hit => Straight edge along the box, Miss => Arc at Range (A few segments so it reads as one)
+		if (front != INDEX_NONE)
+		{
+			for (const float angle : { Low, High })
+			{
+				float distance = frontDistance;
+				RayEntersBox(Cone.Apex, RotateVector2D(Cone.Direction, angle), Boxes[front], distance);
+				addPolygonPoint(angle, distance);
+			}
+		}
+		else
+		{
+			const int32 numSegments = FMath::Max(1, FMath::CeilToInt((High - Low) / FMath::DegreesToRadians(5.f)));
+			for (int32 i = 0; i <= numSegments; ++i)
+				addPolygonPoint(Low + (High - Low) * i / numSegments, Cone.Range);
+		}
+	};
+
+	if (OutPolygon)
+		OutPolygon->Add(Cone.Apex);
+
+
+
+	// 3. Sweep
+	float previous = -Cone.HalfAngle;
+	for (int32 i = 0; i <= Events.Num(); ++i)
+	{
+		const float next = i < Events.Num() ? Events[i].Angle : Cone.HalfAngle;
+		if (next > previous)
+		{
+			processInterval(previous, next);
+			previous = next;
+		}
+
+		if (i == Events.Num())
+			break;
+
+		if (Events[i].bStart)
+			Active.Add(Events[i].Box);
+		else
+			Active.RemoveSingleSwap(Events[i].Box, false);
+	}
+
+	for (TConstSetBitIterator<> it(Visible); it; ++it)
+		OutVisible.Add(it.GetIndex());
+}
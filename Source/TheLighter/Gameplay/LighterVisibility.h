@@ -0,0 +1,54 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Exact 2D visibility of the LighterBlocks inside the SpotLight's cone
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LighterBlockGrid.h"
+
+
+/*
+* The RayFan only knows about the blocks its N rays happen to hit first
+* The ConeQuery lights EVERYTHING in the cone, even blocks hidden behind other blocks
+*
+* This is what the light ACTUALLY reaches
+* Every LighterBlock blocks the Lighter channel, so every block is also an OCCLUDER
+*
+* ANGULAR SWEEP
+* -------------
+* 1. Every candidate box covers an angular interval as seen from the apex (Clipped to the cone)
+* 2. Sort the interval end points => The cone splits into ELEMENTARY intervals
+* 		Inside one of those, the set of boxes covering it never changes
+* 3. Sweep them in order, keeping the ACTIVE boxes (Start => Add, End => Remove)
+* 4. Per elementary interval, the nearest active box along its middle ray is the one in front
+* 		a. Disjoint boxes can't swap depth order inside an interval they both fully cover
+* 		b. It's lit if the light reaches it within Range anywhere in that interval (Exact sub-wedge test)
+*
+* The front-most hits, joined up, are the visibility POLYGON (Only built for debug drawing)
+*
+* NOTE: A box the apex is inside of is lit, but doesn't occlude (The ball's passing through it)
+*/
+
+class FLighterVisibility
+{
+public:
+	// Indices into Boxes of every box the light reaches
+	void Compute(const FLighterCone& Cone, TArrayView<const FBox2D> Boxes, TArray<int32>& OutVisible, TArray<FVector2D>* OutPolygon = nullptr);
+
+private:
+	struct FSweepEvent
+	{
+		float Angle;
+		int32 Box;
+		bool bStart;
+
+		FORCEINLINE bool operator<(const FSweepEvent& Other) const { return Angle < Other.Angle || (Angle == Other.Angle && !bStart && Other.bStart); }
+	};
+
+	void AddInterval(const int32 Box, const float Low, const float High, const float HalfAngle);
+
+	// Reused every query
+	TArray<FSweepEvent> Events;
+	TArray<int32> Active;
+	TBitArray<> Visible;
+};
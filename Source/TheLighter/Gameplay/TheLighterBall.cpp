@@ -2,18 +2,79 @@
 // Extending Unreal's Pawn class to gain PlayerControl features
 
 #include "TheLighterBall.h"
+#include "TheLighter.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Camera/CameraComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Components/InputComponent.h"
 #include "GameFramework/SpringArmComponent.h"
+#include "GameFramework/PlayerInput.h"
 #include "Engine/CollisionProfile.h"
+#include "PhysicsEngine/PhysicsSettings.h"
 #include "Engine/StaticMesh.h"
 #include "Components/SpotLightComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Block.h"
+#include "BlockField.h"
+#include "LighterBlockSubsystem.h"
+#include "LighterEffectSubsystem.h"
 #include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Engine/GameViewportClient.h"
+#include "Slate/SceneViewport.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Net/UnrealNetwork.h"
+#include "HAL/IConsoleManager.h"
+
+
+static TAutoConsoleVariable<float> CVarLighterNetOwnerStateRate(
+	TEXT("Lighter.Net.OwnerStateRate"),
+	30.f,
+	TEXT("Times a second an owning client sends its ball's location, velocity & tracer rotation to the server"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLighterSubstepTracer(
+	TEXT("Lighter.SubstepTracer"),
+	1,
+	TEXT("1 => A ball moving more than Lighter.SubstepTracer.Distance in a frame also traces at every physics substep along its path\n")
+	TEXT("     & everything it lights turns solid before physics steps through it\n")
+	TEXT("0 => One trace a frame, from where the ball is"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLighterSubstepTracerDistance(
+	TEXT("Lighter.SubstepTracer.Distance"),
+	50.f,
+	TEXT("Most a ball can move between two traces (Units), more than that in a frame turns the substep tracer on"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarLighterBallCCD(
+	TEXT("Lighter.BallCCD"),
+	1,
+	TEXT("1 => Continuous collision detection on the balls' bodies (Read on BeginPlay)\n")
+	TEXT("0 => Discrete, a fast enough ball can step right over a thin block"),
+	ECVF_Default);
+
+// Never more traces than this per frame, however fast the ball is
+static const int32 LighterMaxTracerSubsteps = 16;
+
+static TAutoConsoleVariable<int32> CVarLighterContactGrounding(
+	TEXT("Lighter.ContactGrounding"),
+	1,
+	TEXT("1 => Grounded & walled come from the contacts physics reports, the rays only run when those can't be trusted (Spawn, restore)\n")
+	TEXT("0 => Grounding & walling rays every frame, contacts ignored"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarLighterContactGrace(
+	TEXT("Lighter.ContactGrace"),
+	0.1f,
+	TEXT("Seconds a contact still counts after physics last reported it (Bounces & block seams break contact for a step or two)"),
+	ECVF_Default);
 
 
 
@@ -33,6 +94,7 @@ ATheLighterBall::ATheLighterBall()
 	Ball->BodyInstance.MassScale = 3.5f;
 	Ball->BodyInstance.MaxAngularVelocity = 800.0f;
 	Ball->SetNotifyRigidBodyCollision(true);
+	Ball->OnComponentEndOverlap.AddDynamic(this, &ATheLighterBall::OnBallEndOverlap);
 	RootComponent = Ball;
 
 	// Constraint
@@ -65,6 +127,15 @@ ATheLighterBall::ATheLighterBall()
 	
 	// Set up forces
 	RollTorque = 50.f;
+
+	// Co-op => Other players see our ball through the replicated movement (See NETWORK)
+	bReplicates = true;
+	SetReplicatingMovement(true);
+
+	// Async probe callbacks
+	TracerProbeDelegate.BindUObject(this, &ATheLighterBall::OnTracerProbeDone);
+	GroundingProbeDelegate.BindUObject(this, &ATheLighterBall::OnGroundingProbeDone);
+	WallingProbeDelegate.BindUObject(this, &ATheLighterBall::OnWallingProbeDone);
 }
 
 void ATheLighterBall::SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent)
@@ -95,17 +166,62 @@ void ATheLighterBall::SetupPlayerInputComponent(class UInputComponent* PlayerInp
 #pragma region BEGINPLAY & TICK
 void ATheLighterBall::BeginPlay()
 {
+	LIGHTER_LLM_SCOPE();
 	Super::BeginPlay();
 
 	// Initial Config
 	if (MaxAngularVelocity > 0.f)
 		Ball->SetPhysicsMaxAngularVelocityInRadians(MaxAngularVelocity);
+	Ball->SetUseCCD(CVarLighterBallCCD.GetValueOnGameThread() != 0);
 
 	// Set Tracer cone angle on play start
 	TraceAngle = SpotLight->OuterConeAngle - TraceAngleCorrection;
 	TargetTracerRotation = FRotator(0, 90, 0);
 
+	// Light source & collider, as far as the LighterBlocks are concerned
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+	{
+		EmitterId = subsystem->RegisterEmitter();
+		subsystem->RegisterBall(this);
+	}
+
+	// Effect components up front, so the first events don't have to create any
+	if (ULighterEffectSubsystem* effects = GetWorld()->GetSubsystem<ULighterEffectSubsystem>())
+	{
+		effects->Prewarm(DoubleJumpEffect);
+		effects->Prewarm(ExitImpulseEffect);
+	}
+
 	DrawDebugSphere(GetWorld(), LastPointerLocation, 100.f, 64, FColor::Red);
+	// Whole-session record / replay from the command line (See LighterInputRecording.h)
+	FString recordingName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("LighterReplay="), recordingName))
+		StartInputReplay(recordingName, FParse::Param(FCommandLine::Get(), TEXT("LighterReplayQuit")));
+	else if (FParse::Value(FCommandLine::Get(), TEXT("LighterRecord="), recordingName))
+		StartInputRecording();
+}
+
+void ATheLighterBall::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FString recordingName;
+	if (InputMode == ELighterInputMode::Recording)
+		StopInputRecording(FParse::Value(FCommandLine::Get(), TEXT("LighterRecord="), recordingName) ? recordingName : FDateTime::Now().ToString());
+	else if (InputMode == ELighterInputMode::Replaying)
+		StopInputReplay();
+
+	if (PointerInput.IsValid() && FSlateApplication::IsInitialized())
+		FSlateApplication::Get().UnregisterInputPreProcessor(PointerInput);
+	PointerInput.Reset();
+
+	// Whatever only we were lighting goes back to PassThrough
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+	{
+		subsystem->UnregisterEmitter(EmitterId);
+		subsystem->UnregisterBall(this);
+	}
+	EmitterId = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -114,35 +230,63 @@ void ATheLighterBall::BeginPlay()
 
 void ATheLighterBall::Tick(float DeltaSeconds)
 {
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterBallTick);
+	LIGHTER_LLM_SCOPE();
+
 	Super::Tick(DeltaSeconds);
 
-	// Query for Tracer Control
-	APlayerController * playerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-	if (!bDisableTracerControl)
-	{
-		QueryMouseInput(playerController);
-		QueryGamepadInput(playerController);
-	}
+	// This frame's input => Live, or the next recorded frame
+	// A replay runs on the RECORDED frame time
+	// Our own controller, so every local player drives their own ball
+	APlayerController * playerController = Cast<APlayerController>(GetController());
+	GatherInput(playerController, DeltaSeconds);
+	const float deltaSeconds = PendingInput.DeltaSeconds;
+	ApplyInput();
 
 	// Use SMOOTH interpolation to rotate the flashlight
-	LerpTracerToTargetRotation(DeltaSeconds);
+	LerpTracerToTargetRotation(deltaSeconds);
 
+	// Our own ball in a networked game => The server needs to know where it is & where it's pointing
+	if (!HasAuthority() && IsLocallyControlled())
+		SendOwnerState();
 
-	// Invoke the TRACER-ALGORITHM
-	TraceCollision();
 
+	TracerDeltaSeconds = deltaSeconds;
+	if (bAsyncProbes)
+	{
+		// Last frame's batch => Tracer-Algorithm & Jump Toggle
+		// Then fire this frame's batch (Grounding & walling rays only if the contacts can't be trusted)
+		ConsumeAsyncProbes();
+		SubmitAsyncProbes(!UpdateContactState());
+	}
+	else
+	{
+		// Invoke the TRACER-ALGORITHM
+		if (IsTracedLocally())
+			TraceCollision();
 
-	// Jump Toggle
-	bIsGrounded = TraceGrounding();
+
+		// Jump & Wall Toggles
+		if (!UpdateContactState())
+		{
+			bIsGrounded = TraceGrounding();
+			WalledDirection = TraceWalling();
+			bIsWalled = WalledDirection != WallingDirection::None;
+		}
+
+		bHasAsyncResults = false;
+	}
 
 	// Gravity Correction
 	Ball->AddForce(FVector::DownVector * GravityMultiplier);
 
 	// Double Jump Logic
 	if (bIsGrounded)
-		GroundedTime += DeltaSeconds;
+		GroundedTime += deltaSeconds;
 	else
 		GroundedTime = 0.0f;
+
+	FinishInputFrame();
 }
 #pragma endregion BEGINPLAY & TICK
 ////////////////////////////////////////////////////////////////////// EVENTS
@@ -204,6 +348,9 @@ void ATheLighterBall::Tick(float DeltaSeconds)
 * 		a. Call the ToggleCollision again to disable collision
 * 		b. Remove it from the list
 * 
+* 4. Steps 2 & 3 are ONE diff pass between the HitSet & the LitSet (See FLighterBlockSet)
+* 		So the cost is linear in the number of hit + lit blocks
+* 
 * 
 * NOTE: The ToggleCollision function only sets the target collision,
 * 		But the real collision change occurs when NOTHING's overlapping the LighterBlock
@@ -216,19 +363,101 @@ void ATheLighterBall::Tick(float DeltaSeconds)
 ////////////////////////////////////////////////////////////////////// TRACER
 #pragma region TRACER
 void ATheLighterBall::TraceCollision()
+{
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterTraceCollision);
+
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem) return;
+
+	// Whatever gets lit now comes from the current aim
+	subsystem->SetEmitterInputTrace(EmitterId, AimTrace);
+
+	// RayFan => We trace, the subsystem only gets the HITSET
+	if (TracerMode == ETracerMode::RayFan)
+	{
+		// Populate HITSET
+		HitSet.Reset();
+		TraceRayFan(HitSet);
+		TraceSubsteps(HitSet, GetNumTracerSubsteps());
+		// Populate HITSET
+
+
+
+
+		// Tracer Algorithm
+		UpdateLitSet();
+		// Tracer Algorithm
+		return;
+	}
+
+	// Fast ball => Self-traced this frame (Our cone now + every substep's, as one HITSET)
+	// The batched pass picks us back up as soon as we slow down (SetEmitterCone)
+	const int32 numSubsteps = GetNumTracerSubsteps();
+	if (numSubsteps > 0)
+	{
+		HitSet.Reset();
+		TraceHitSet(HitSet);
+		TraceSubsteps(HitSet, numSubsteps);
+		UpdateLitSet();
+		return;
+	}
+
+	// Analytic modes => Just hand in the cone
+	// The subsystem resolves every ball & lamp in one batched pass (And skips us entirely if the cone didn't move)
+	const FLighterCone cone = GetTracerCone();
+	subsystem->SetEmitterCone(EmitterId, cone, TracerMode == ETracerMode::Visibility ? ELighterEmitterQuery::Visibility : ELighterEmitterQuery::Cone);
+
+	if (bShowDebugTrace)
+	{
+		const FVector actorLocation = GetActorLocation();
+		const FVector spotLightDirection = SpotLight->GetForwardVector();
+		const FVector debugOffset = FVector::BackwardVector * TraceForwardCorrection;
+		const FVector leftEdge = spotLightDirection.RotateAngleAxis(TraceAngle, FVector::ForwardVector);
+		const FVector rightEdge = spotLightDirection.RotateAngleAxis(-TraceAngle, FVector::ForwardVector);
+		DrawDebugLine(GetWorld(), actorLocation + debugOffset, actorLocation + leftEdge * TraceLength + debugOffset, FColor::Red);
+		DrawDebugLine(GetWorld(), actorLocation + debugOffset, actorLocation + rightEdge * TraceLength + debugOffset, FColor::Red);
+
+		if (const FLighterBlockSet* litSet = GetLitSet())
+			for (const int32 blockIndex : litSet->GetMembers())
+			{
+				const FBox2D bounds = subsystem->GetBlockBounds(blockIndex);
+				const FVector center(actorLocation.X, bounds.GetCenter().X, bounds.GetCenter().Y);
+				const FVector extent(1.f, bounds.GetExtent().X, bounds.GetExtent().Y);
+				DrawDebugBox(GetWorld(), center + debugOffset, extent, FColor::Red);
+			}
+	}
+}
+
+void ATheLighterBall::TraceHitSet(FLighterBlockSet& hitSet)
+{
+	switch (TracerMode)
+	{
+	case ETracerMode::ConeQuery:	TraceCone(hitSet); break;
+	case ETracerMode::Visibility:	TraceVisibility(hitSet); break;
+	default:						TraceRayFan(hitSet); break;
+	}
+}
+
+FVector ATheLighterBall::GetRayFanDirection(const int32 TraceIndex) const
 {
 	const FRotator spotLightRotation = SpotLight->GetComponentRotation();
-	TArray<ABlock*> hitSet;
+	const FRotator lineRotation = UKismetMathLibrary::ComposeRotators(spotLightRotation, FRotator(0, 0, -TraceAngle + (TraceAngle * 2 * TraceIndex / (NumberOfTraces - 1))));
+	return lineRotation.Vector();
+}
+
+void ATheLighterBall::TraceRayFan(FLighterBlockSet& hitSet)
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem) return;
 
-	
 	// EVENLY ANGLED LINE TRACES
 	// To populate the HITSET
+	LIGHTER_INC_COUNTER(STAT_LighterTraces, NumberOfTraces);
 
 	for (int i = 0; i < NumberOfTraces; i++)
 	{
-		const FRotator lineRotation = UKismetMathLibrary::ComposeRotators(spotLightRotation, FRotator(0, 0, -TraceAngle + (TraceAngle * 2 * i / (NumberOfTraces - 1))));
 		const FVector traceStart = GetActorLocation();
-		const FVector traceEnd = GetActorLocation() + lineRotation.Vector() * TraceLength;
+		const FVector traceEnd = GetActorLocation() + GetRayFanDirection(i) * TraceLength;
 
 		FHitResult outHit;
 		GetWorld()->LineTraceSingleByChannel(outHit, traceStart, traceEnd, ECollisionChannel::ECC_GameTraceChannel1);
@@ -241,59 +470,254 @@ void ATheLighterBall::TraceCollision()
 				FColor::Red);
 
 		if (outHit.bBlockingHit)
-			SetAdd(hitSet, Cast<ABlock>(outHit.GetActor()), false);
+		{
+			const int32 blockIndex = subsystem->GetBlockIndexFromHit(outHit);
+			if (blockIndex != INDEX_NONE)
+				hitSet.Add(blockIndex);
+		}
 	}
-	// Populate HITSET
-	
+}
 
 
 
-	// Tracer Algorithm
-	if (LitSet.Num() == 0)
-	{
-		for (ABlock* hitActor : hitSet)
-			SetAdd(LitSet, hitActor, true);
-	}
-	else
+// Same cone as the RayFan, but tested analytically against every block's bounds
+// Cost depends on the blocks near the cone, NOT on the number of rays
+
+void ATheLighterBall::TraceCone(FLighterBlockSet& hitSet)
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem) return;
+
+	const FVector actorLocation = GetActorLocation();
+	const FVector spotLightDirection = SpotLight->GetForwardVector();
+	const FLighterCone cone = GetTracerCone();
+
+	TraceScratch.Reset();
+	subsystem->QueryCone(cone, TraceScratch);
+	for (const int32 blockIndex : TraceScratch)
+		hitSet.Add(blockIndex);
+
+	if (bShowDebugTrace)
 	{
-		for (int i = 0; i < LitSet.Num(); ++i)
+		const FVector debugOffset = FVector::BackwardVector * TraceForwardCorrection;
+		const FVector leftEdge = spotLightDirection.RotateAngleAxis(TraceAngle, FVector::ForwardVector);
+		const FVector rightEdge = spotLightDirection.RotateAngleAxis(-TraceAngle, FVector::ForwardVector);
+		DrawDebugLine(GetWorld(), actorLocation + debugOffset, actorLocation + leftEdge * TraceLength + debugOffset, FColor::Red);
+		DrawDebugLine(GetWorld(), actorLocation + debugOffset, actorLocation + rightEdge * TraceLength + debugOffset, FColor::Red);
+
+		for (const int32 blockIndex : hitSet.GetMembers())
 		{
-			if (!hitSet.Contains(LitSet[i]))
-			{
-				SetRemove(LitSet, LitSet[i], true);
-				continue;
-			}
-			for (ABlock* hitActor : hitSet)
-			{
-				SetAdd(LitSet, hitActor, true);
-			}
+			const FBox2D bounds = subsystem->GetBlockBounds(blockIndex);
+			const FVector center(actorLocation.X, bounds.GetCenter().X, bounds.GetCenter().Y);
+			const FVector extent(1.f, bounds.GetExtent().X, bounds.GetExtent().Y);
+			DrawDebugBox(GetWorld(), center + debugOffset, extent, FColor::Red);
 		}
 	}
-	// Tracer Algorithm
 }
 
-bool ATheLighterBall::SetAdd(TArray<ABlock*>& arrayRef, ABlock* actorRef, const bool bCollisionToggle)
+FLighterCone ATheLighterBall::GetTracerCone() const
+{
+	return GetTracerCone(GetActorLocation(), SpotLight->GetForwardVector());
+}
+
+FLighterCone ATheLighterBall::GetTracerCone(const FVector& Location, const FVector& Direction) const
 {
-	if (!arrayRef.Contains(actorRef))
+	// TraceAngle => OuterConeAngle - TraceAngleCorrection, so it's the rendered cone
+	return FLighterCone(ToLighterPlane(Location), ToLighterPlane(Direction), TraceAngle, TraceLength);
+}
+
+// Where the cone is going to be, a frame at a time
+// 		Tracer	=> The same RInterpTo LerpTracerToTargetRotation runs, towards the current target
+// 		Ball	=> Current velocity + gravity & our own gravity correction (Damping & contacts left out, it's only a few frames)
+
+// Resting with the SpotLight already where it's going => The cone can't reach anything it hasn't lit, nothing to stage
+
+void ATheLighterBall::StagePrelight(const int32 Frames)
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	const float deltaSeconds = TracerDeltaSeconds;
+	if (Frames <= 0 || !subsystem || deltaSeconds <= 0.f) return;
+
+	FRotator rotation = SpotLight->GetComponentRotation();
+	FVector velocity = Ball->GetPhysicsLinearVelocity();
+	if (bIsGrounded && velocity.IsNearlyZero(1.f) && rotation.Equals(TargetTracerRotation, 0.1f)) return;
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterStagePrelight);
+
+	FVector location = GetActorLocation();
+	const FVector acceleration = GetPredictedAcceleration();
+
+	PrelightCones.Reset();
+	for (int32 frame = 0; frame < Frames; ++frame)
 	{
-		if (bCollisionToggle && actorRef->TargetCollisionResponse != ECR_Block)
-			actorRef->TargetCollisionResponse = ECR_Block;
-		arrayRef.Add(actorRef);
-		return true;
+		rotation = UKismetMathLibrary::RInterpTo(rotation, TargetTracerRotation, deltaSeconds, TracerSpeed);
+		velocity += acceleration * deltaSeconds;
+		location += velocity * deltaSeconds;
+		PrelightCones.Add(GetTracerCone(location, FRotator(rotation.Pitch, rotation.Yaw, 0.f).Vector()));
 	}
-	return false;
+
+	// Every frame's cone in one go => One grid query
+	subsystem->StagePrelight(PrelightCones, Frames);
 }
 
-bool ATheLighterBall::SetRemove(TArray<ABlock*>& arrayRef, ABlock* actorRef, const bool bCollisionToggle)
+
+
+FVector ATheLighterBall::GetPredictedAcceleration() const
 {
-	if (arrayRef.Contains(actorRef))
+	const float gravityZ = Ball->IsGravityEnabled() ? GetWorld()->GetGravityZ() : 0.f;
+	return FVector(0.f, 0.f, gravityZ) + FVector::DownVector * GravityMultiplier / FMath::Max(Ball->GetMass(), KINDA_SMALL_NUMBER);
+}
+
+
+
+// The ConeQuery's candidates, minus everything hidden behind another block
+// See LighterVisibility.h for the sweep
+
+void ATheLighterBall::TraceVisibility(FLighterBlockSet& hitSet)
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem) return;
+
+	const FLighterCone cone = GetTracerCone();
+
+	TraceScratch.Reset();
+	subsystem->QueryCone(cone, TraceScratch);
+
+	BoundsScratch.Reset();
+	for (const int32 blockIndex : TraceScratch)
+		BoundsScratch.Add(subsystem->GetBlockBounds(blockIndex));
+
+	VisibleScratch.Reset();
+	Visibility.Compute(cone, BoundsScratch, VisibleScratch, bShowDebugTrace ? &PolygonScratch : nullptr);
+	for (const int32 candidate : VisibleScratch)
+		hitSet.Add(TraceScratch[candidate]);
+
+	if (bShowDebugTrace && PolygonScratch.Num() > 1)
 	{
-		if (bCollisionToggle && actorRef->TargetCollisionResponse != ECR_Overlap)
-			actorRef->TargetCollisionResponse = ECR_Overlap;
-		arrayRef.Remove(actorRef);
-		return true;
+		const float x = GetActorLocation().X;
+		const FVector debugOffset = FVector::BackwardVector * TraceForwardCorrection;
+		for (int32 i = 0; i < PolygonScratch.Num(); ++i)
+		{
+			const FVector2D& a = PolygonScratch[i];
+			const FVector2D& b = PolygonScratch[(i + 1) % PolygonScratch.Num()];
+			DrawDebugLine(GetWorld(), FVector(x, a.X, a.Y) + debugOffset, FVector(x, b.X, b.Y) + debugOffset, FColor::Yellow);
+		}
 	}
-	return false;
+}
+
+/*
+* SUBSTEP TRACER
+* --------------
+* Booster chains get the ball moving faster than one trace a frame can keep up with
+* 		=> Blocks the ball reaches mid-frame aren't lit yet, physics steps right through them
+*
+* The substep callbacks run on the physics thread, where no scene query or collision change is allowed
+* So the Tracer walks the SAME substeps (UPhysicsSettings) here instead, before physics starts
+* 		1. Predict the ball at the end of every substep (Velocity + gravity, the SpotLight doesn't move mid-frame)
+* 		2. Trace the cone from there into the HITSET
+* 		3. Stage the whole HITSET => Whatever it lights is committed right away, not after physics (See PRE-LIGHTING)
+*
+* CCD on the ball's body (Lighter.BallCCD) covers the other half, blocks thinner than a substep's travel
+*/
+
+int32 ATheLighterBall::GetNumTracerSubsteps() const
+{
+	if (CVarLighterSubstepTracer.GetValueOnGameThread() == 0 || TracerDeltaSeconds <= 0.f) return 0;
+
+	const float travel = Ball->GetPhysicsLinearVelocity().Size() * TracerDeltaSeconds;
+	const float distance = FMath::Max(1.f, CVarLighterSubstepTracerDistance.GetValueOnGameThread());
+	if (travel <= distance) return 0;
+
+	// As many as physics takes, more if even those are too far apart
+	int32 physicsSubsteps = 1;
+	const UPhysicsSettings* physicsSettings = UPhysicsSettings::Get();
+	if (physicsSettings->bSubstepping && physicsSettings->MaxSubstepDeltaTime > 0.f)
+		physicsSubsteps = FMath::Clamp(FMath::CeilToInt(FMath::Min(TracerDeltaSeconds, physicsSettings->MaxPhysicsDeltaTime) / physicsSettings->MaxSubstepDeltaTime), 1, physicsSettings->MaxSubsteps);
+
+	return FMath::Clamp(FMath::Max(physicsSubsteps, FMath::CeilToInt(travel / distance)), 1, LighterMaxTracerSubsteps);
+}
+
+void ATheLighterBall::TraceSubsteps(FLighterBlockSet& hitSet, const int32 NumSubsteps)
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (NumSubsteps <= 0 || !subsystem) return;
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterTraceSubsteps);
+
+	const float substepSeconds = TracerDeltaSeconds / NumSubsteps;
+	const FVector direction = SpotLight->GetForwardVector();
+	const FVector acceleration = GetPredictedAcceleration();
+	FVector location = GetActorLocation();
+	FVector velocity = Ball->GetPhysicsLinearVelocity();
+
+	for (int32 substep = 0; substep < NumSubsteps; ++substep)
+	{
+		velocity += acceleration * substepSeconds;
+		location += velocity * substepSeconds;
+
+		if (TracerMode == ETracerMode::RayFan)
+		{
+			LIGHTER_INC_COUNTER(STAT_LighterTraces, NumberOfTraces);
+			for (int32 i = 0; i < NumberOfTraces; ++i)
+			{
+				FHitResult outHit;
+				if (GetWorld()->LineTraceSingleByChannel(outHit, location, location + GetRayFanDirection(i) * TraceLength, ECollisionChannel::ECC_GameTraceChannel1))
+				{
+					const int32 blockIndex = subsystem->GetBlockIndexFromHit(outHit);
+					if (blockIndex != INDEX_NONE)
+						hitSet.Add(blockIndex);
+				}
+			}
+			continue;
+		}
+
+		const FLighterCone cone = GetTracerCone(location, direction);
+		TraceScratch.Reset();
+		subsystem->QueryCone(cone, TraceScratch);
+
+		if (TracerMode == ETracerMode::Visibility)
+		{
+			BoundsScratch.Reset();
+			for (const int32 blockIndex : TraceScratch)
+				BoundsScratch.Add(subsystem->GetBlockBounds(blockIndex));
+
+			VisibleScratch.Reset();
+			Visibility.Compute(cone, BoundsScratch, VisibleScratch);
+			for (const int32 candidate : VisibleScratch)
+				hitSet.Add(TraceScratch[candidate]);
+		}
+		else
+		{
+			for (const int32 blockIndex : TraceScratch)
+				hitSet.Add(blockIndex);
+		}
+
+		if (bShowDebugTrace)
+			DrawDebugSphere(GetWorld(), location + FVector::BackwardVector * TraceForwardCorrection, 10.f, 8, FColor::Orange);
+	}
+
+	// Physics is about to step through all of it => Solid the moment it's lit
+	subsystem->StageBlocks(hitSet.GetMembers(), 0);
+}
+
+
+
+// One linear diff between the HITSET & our emitter's LITSET (In the LighterBlockSubsystem)
+// Collision only gets toggled on the blocks whose lit count goes 0 <=> 1
+
+void ATheLighterBall::UpdateLitSet()
+{
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterUpdateLitSet);
+
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem) return;
+
+	subsystem->SetEmitterHits(EmitterId, HitSet);
+	HitSet.Reset();
+}
+
+const FLighterBlockSet* ATheLighterBall::GetLitSet() const
+{
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	return subsystem ? subsystem->GetEmitterLitSet(EmitterId) : nullptr;
 }
 
 
@@ -307,12 +731,22 @@ bool ATheLighterBall::SetRemove(TArray<ABlock*>& arrayRef, ABlock* actorRef, con
 // This trace tells us if the PlayerBall is allowed to jump
 // PREVENTS the JUMP-SKIP when the PlayerBall is on a SLOPE while MOVING FAST
 
+void ATheLighterBall::GetGroundingTraceEnds(FVector& OutLeft, FVector& OutRight) const
+{
+	OutRight = GetActorLocation() + (FVector::UpVector * -TraceGroundingThreshold) + (FVector::RightVector * TraceGroundingSeparation);
+	OutLeft = OutRight + (FVector::RightVector * -2.f * TraceGroundingSeparation);
+}
+
 bool ATheLighterBall::TraceGrounding()
 {
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterTraceGrounding);
+	LIGHTER_INC_COUNTER(STAT_LighterTraces, 2);
+
 	UWorld* world = GetWorld();
 	const FVector startLocation = GetActorLocation();
-	const FVector rightTraceLocation = GetActorLocation() + (FVector::UpVector * -TraceGroundingThreshold) + (FVector::RightVector * TraceGroundingSeparation);
-	const FVector leftTraceLocation = rightTraceLocation + (FVector::RightVector * -2.f * TraceGroundingSeparation);
+	FVector leftTraceLocation;
+	FVector rightTraceLocation;
+	GetGroundingTraceEnds(leftTraceLocation, rightTraceLocation);
 
 	if (bShowDebugTrace)
 	{
@@ -343,12 +777,22 @@ bool ATheLighterBall::TraceGrounding()
 // This is a separate trace just to tell if we're close to the walls
 // Useful to PREVENT WALL CLIMB since we're applying LATERAL FORCES
 
+void ATheLighterBall::GetWallingTraceEnds(FVector& OutLeft, FVector& OutRight) const
+{
+	OutRight = GetActorLocation() + (FVector::RightVector * TraceWallingThreshold);
+	OutLeft = OutRight + (FVector::RightVector * -2.f * TraceWallingThreshold);
+}
+
 WallingDirection ATheLighterBall::TraceWalling()
 {
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterTraceWalling);
+	LIGHTER_INC_COUNTER(STAT_LighterTraces, 2);
+
 	UWorld* world = GetWorld();
 	const FVector startLocation = GetActorLocation();
-	const FVector rightTraceLocation = GetActorLocation() + (FVector::RightVector * TraceWallingThreshold);
-	const FVector leftTraceLocation = rightTraceLocation + (FVector::RightVector * -2.f * TraceWallingThreshold);
+	FVector leftTraceLocation;
+	FVector rightTraceLocation;
+	GetWallingTraceEnds(leftTraceLocation, rightTraceLocation);
 
 	if (bShowDebugTrace)
 	{
@@ -373,6 +817,142 @@ WallingDirection ATheLighterBall::TraceWalling()
 }
 
 
+/*
+* ASYNC PROBES
+* ------------
+* Frame N		=> Submit every Tracer, Grounding & Walling ray as async traces (One batch, Grounding & Walling only without trusted contacts)
+* Frame N + 1	=> The delegates have filled the BACK BUFFER by the time we Tick
+* 				=> Swap it into the FRONT BUFFER (LitSet diff, bIsGrounded & bIsWalled), then submit again
+*
+* NOTE: The ConeQuery & Visibility tracers don't touch the physics scene, so they stay synchronous
+*/
+
+void ATheLighterBall::SubmitAsyncProbes(const bool bProbeGrounding)
+{
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterAsyncProbes);
+	const bool bProbeTracer = TracerMode == ETracerMode::RayFan && IsTracedLocally();
+	LIGHTER_INC_COUNTER(STAT_LighterTraces, (bProbeTracer ? NumberOfTraces : 0) + (bProbeGrounding ? 4 : 0));
+
+	UWorld* world = GetWorld();
+	const FVector startLocation = GetActorLocation();
+	++AsyncProbeBatch;
+	AsyncAimTrace = AimTrace;
+
+	AsyncHitSet.Reset();
+	bAsyncGroundingHit = false;
+	bAsyncWallLeftHit = false;
+	bAsyncWallRightHit = false;
+	bAsyncGroundingProbed = bProbeGrounding;
+
+	if (bProbeTracer)
+		for (int i = 0; i < NumberOfTraces; i++)
+			world->AsyncLineTraceByChannel(EAsyncTraceType::Single, startLocation, startLocation + GetRayFanDirection(i) * TraceLength, ECC_GameTraceChannel1,
+				FCollisionQueryParams::DefaultQueryParam, FCollisionResponseParams::DefaultResponseParam, &TracerProbeDelegate, AsyncProbeBatch);
+
+	if (!bProbeGrounding) return;
+
+	FVector leftTraceLocation;
+	FVector rightTraceLocation;
+	GetGroundingTraceEnds(leftTraceLocation, rightTraceLocation);
+	world->AsyncLineTraceByChannel(EAsyncTraceType::Single, startLocation, leftTraceLocation, ECC_Visibility,
+		FCollisionQueryParams::DefaultQueryParam, FCollisionResponseParams::DefaultResponseParam, &GroundingProbeDelegate, AsyncProbeBatch);
+	world->AsyncLineTraceByChannel(EAsyncTraceType::Single, startLocation, rightTraceLocation, ECC_Visibility,
+		FCollisionQueryParams::DefaultQueryParam, FCollisionResponseParams::DefaultResponseParam, &GroundingProbeDelegate, AsyncProbeBatch);
+
+	FVector leftWallLocation;
+	FVector rightWallLocation;
+	GetWallingTraceEnds(leftWallLocation, rightWallLocation);
+	world->AsyncLineTraceByChannel(EAsyncTraceType::Single, startLocation, leftWallLocation, ECC_Visibility,
+		FCollisionQueryParams::DefaultQueryParam, FCollisionResponseParams::DefaultResponseParam, &WallingProbeDelegate, AsyncProbeBatch);
+	world->AsyncLineTraceByChannel(EAsyncTraceType::Single, startLocation, rightWallLocation, ECC_Visibility,
+		FCollisionQueryParams::DefaultQueryParam, FCollisionResponseParams::DefaultResponseParam, &WallingProbeDelegate, AsyncProbeBatch);
+
+	if (bShowDebugTrace)
+	{
+		DrawDebugLine(world, startLocation + FVector::BackwardVector * TraceForwardCorrection, rightTraceLocation + FVector::BackwardVector * TraceForwardCorrection, FColor::Red);
+		DrawDebugLine(world, startLocation + FVector::BackwardVector * TraceForwardCorrection, leftTraceLocation + FVector::BackwardVector * TraceForwardCorrection, FColor::Red);
+		DrawDebugLine(world, startLocation + FVector::BackwardVector * TraceForwardCorrection, rightWallLocation + FVector::BackwardVector * TraceForwardCorrection, FColor::Red);
+		DrawDebugLine(world, startLocation + FVector::BackwardVector * TraceForwardCorrection, leftWallLocation + FVector::BackwardVector * TraceForwardCorrection, FColor::Red);
+	}
+}
+
+void ATheLighterBall::ConsumeAsyncProbes()
+{
+	// First async frame => Nothing in flight yet, keep the old front buffer
+	if (!bHasAsyncResults)
+	{
+		bHasAsyncResults = true;
+		return;
+	}
+
+	// Another player's ball => Nothing of ours to light (See NETWORK)
+	if (TracerMode == ETracerMode::RayFan && IsTracedLocally())
+	{
+		// The batch was fired with last frame's aim
+		if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+			subsystem->SetEmitterInputTrace(EmitterId, AsyncAimTrace);
+
+		// Last frame's rays, but this frame's substeps (Synchronous, physics is about to step through them)
+		Swap(HitSet, AsyncHitSet);
+		TraceSubsteps(HitSet, GetNumTracerSubsteps());
+		UpdateLitSet();
+	}
+	else if (IsTracedLocally())
+		TraceCollision();
+
+	// Contacts come after this & win when they're trusted
+	if (bAsyncGroundingProbed)
+	{
+		bIsGrounded = bAsyncGroundingHit;
+		WalledDirection = bAsyncWallLeftHit && bAsyncWallRightHit ? WallingDirection::Both : bAsyncWallLeftHit ? WallingDirection::Left : bAsyncWallRightHit ? WallingDirection::Right : WallingDirection::None;
+		bIsWalled = WalledDirection != WallingDirection::None;
+	}
+}
+
+void ATheLighterBall::OnTracerProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (TraceDatum.UserData != AsyncProbeBatch) return;
+
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem) return;
+
+	for (const FHitResult& outHit : TraceDatum.OutHits)
+	{
+		if (bShowDebugTrace)
+			DrawDebugLine(GetWorld(), TraceDatum.Start + FVector::BackwardVector * TraceForwardCorrection, outHit.ImpactPoint + FVector::BackwardVector * TraceForwardCorrection, FColor::Red);
+
+		if (outHit.bBlockingHit)
+		{
+			const int32 blockIndex = subsystem->GetBlockIndexFromHit(outHit);
+			if (blockIndex != INDEX_NONE)
+				AsyncHitSet.Add(blockIndex);
+		}
+	}
+}
+
+void ATheLighterBall::OnGroundingProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (TraceDatum.UserData != AsyncProbeBatch) return;
+
+	for (const FHitResult& outHit : TraceDatum.OutHits)
+		if (outHit.bBlockingHit)
+			bAsyncGroundingHit = true;
+}
+
+void ATheLighterBall::OnWallingProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	if (TraceDatum.UserData != AsyncProbeBatch) return;
+
+	// Both rays share the delegate => The end tells us which side this one was
+	const bool bLeft = TraceDatum.End.Y < TraceDatum.Start.Y;
+	for (const FHitResult& outHit : TraceDatum.OutHits)
+		if (outHit.bBlockingHit)
+			(bLeft ? bAsyncWallLeftHit : bAsyncWallRightHit) = true;
+}
+
+
+
+
 // Set tracer rotation smoothly
 void ATheLighterBall::SetTracerRotation(const FVector Direction)
 {
@@ -385,9 +965,12 @@ void ATheLighterBall::SetTracerRotation(const FVector Direction)
 
 void ATheLighterBall::LerpTracerToTargetRotation(const float DeltaSeconds)
 {
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterLerpTracer);
+
 	const FRotator spotLightRotation = SpotLight->GetComponentRotation();
 	const FRotator newRotation = UKismetMathLibrary::RInterpTo(spotLightRotation, TargetTracerRotation, DeltaSeconds, TracerSpeed);
 	SpotLight->SetWorldRotation(FRotator(newRotation.Pitch, newRotation.Yaw, 0));
+	CurrentTracerRotation = SpotLight->GetComponentRotation();
 }
 #pragma endregion TRACER
 ////////////////////////////////////////////////////////////////////// TRACER
@@ -438,6 +1021,24 @@ void ATheLighterBall::EnablePlayerInput()
 
 ////////////////////////////////////////////////// Ball Movement Control
 void ATheLighterBall::MoveRight(float Val)
+{
+	if (IsReplayingInput()) return;
+
+	// Axes fire every frame, only a new value is a new sample
+	if (Val != PendingInput.MoveRight)
+		MoveRightTrace = BeginInputTrace(ELighterInputSource::MoveRight, GetInputArrivalTime(TEXT("MoveRight"), true));
+	PendingInput.MoveRight = Val;
+}
+
+void ATheLighterBall::Jump()
+{
+	if (IsReplayingInput()) return;
+
+	JumpTrace = BeginInputTrace(ELighterInputSource::Jump, GetInputArrivalTime(TEXT("Jump"), false));
+	PendingInput.bJump = true;
+}
+
+void ATheLighterBall::ApplyMoveRight(const float Val)
 {
 	if (bDisableMovement) return;
 
@@ -446,9 +1047,12 @@ void ATheLighterBall::MoveRight(float Val)
 		Ball->AddForce(Force);
 	else
 		Ball->AddForce(bDisableAirControl ? FVector::ZeroVector : Force);
+
+	if (bIsGrounded || !bDisableAirControl)
+		MarkInputApplied(MoveRightTrace, true);
 }
 
-void ATheLighterBall::Jump()
+void ATheLighterBall::ApplyJump()
 {
 	if (bDisableMovement || bDisableJump) return;
 
@@ -459,10 +1063,16 @@ void ATheLighterBall::Jump()
 		if (GroundedTime < DoubleJumpThreshold)
 		{
 			Ball->SetPhysicsLinearVelocity(FVector(ballVelocity.X, ballVelocity.Y, DoubleJumpVelocity));
+			SpawnEffect(DoubleJumpEffect);
 			OnDoubleJump.Broadcast();
 		}
 		else
 			Ball->SetPhysicsLinearVelocity(FVector(ballVelocity.X, ballVelocity.Y, BaseJumpVelocity));
+
+		// The ground we're leaving gets reported once more by the step that lifts us off it
+		LastJumpTime = GetWorld()->GetTimeSeconds();
+
+		MarkInputApplied(JumpTrace, true);
 	}
 }
 ////////////////////////////////////////////////// Ball Movement Control
@@ -491,33 +1101,82 @@ void ATheLighterBall::Jump()
 // Use the relative location to provide a LOOK ANGLE
 // For the flashlight
 
-bool ATheLighterBall::QueryMouseInput(APlayerController* playerController)
+bool ATheLighterBall::QueryMouseInput(APlayerController* playerController, FVector& OutPointerLocation)
 {
+	// HIGH-RATE PATH
+	// Latest move since last frame, projected ONCE (Whatever came before it gets aimed past anyway)
+	// Starts collecting the first time the local player aims with the mouse
+	FSceneViewport* sceneViewport = GetWorld()->GetGameViewport() ? GetWorld()->GetGameViewport()->GetGameViewport() : nullptr;
+	if (!PointerInput.IsValid() && sceneViewport && FSlateApplication::IsInitialized())
+	{
+		PointerInput = MakeShared<FLighterPointerInput>();
+		FSlateApplication::Get().RegisterInputPreProcessor(PointerInput);
+	}
+
+	if (PointerInput.IsValid() && sceneViewport)
+	{
+		const int32 numSamples = PointerInput->GetNumSamples();
+		LIGHTER_INC_COUNTER(STAT_LighterPointerSamples, numSamples);
+		if (numSamples == 0)
+			return false;
+
+		const FLighterPointerSample& sample = PointerInput->GetLatestSample();
+		const double firstSampleTime = PointerInput->GetFirstSampleTime();
+		PointerInput->ResetSamples();
+
+		// Same dead zone as the per-frame path, against the last position we aimed at
+		const FVector2D delta = sample.ScreenPosition - LastPointerScreenPosition;
+		if (fabs(delta.X) < MouseInputThreshold && fabs(delta.Y) < MouseInputThreshold)
+			return false;
+
+		// Desktop space => Viewport pixels
+		const FGeometry& viewportGeometry = sceneViewport->GetCachedGeometry();
+		if (!ProjectPointerToPlane(playerController, viewportGeometry.AbsoluteToLocal(sample.ScreenPosition) * viewportGeometry.Scale, OutPointerLocation))
+			return false;
+
+		LastPointerScreenPosition = sample.ScreenPosition;
+		FirstPointerSampleTime = firstSampleTime;
+		LastPointerSampleTime = sample.Timestamp;
+		return true;
+	}
+
+
+	// PER-FRAME PATH (No Slate)
 	float deltaX;
 	float deltaY;
 	playerController->GetInputMouseDelta(deltaX, deltaY);
 	if (fabs(deltaX) < MouseInputThreshold && fabs(deltaY) < MouseInputThreshold)
 		return false;
-	
-	FVector mouseLocation;
-	FVector mouseDirection;
-	const bool bMouseQuerySuccess = playerController->DeprojectMousePositionToWorld(mouseLocation, mouseDirection);
-	if (bMouseQuerySuccess)
-	{
-		const float HIT_TEST_DISTANCE = SpringArm->TargetArmLength;
 
-		FHitResult hit;
-		GetWorld()->LineTraceSingleByChannel(hit, mouseLocation, mouseLocation + mouseDirection * HIT_TEST_DISTANCE, ECollisionChannel::ECC_Visibility);
-		const FVector mouseWorldLocation = hit.TraceEnd;
-		LastPointerLocation = mouseWorldLocation;
+	FirstPointerSampleTime = FPlatformTime::Seconds();
+	FVector2D mousePosition;
+	return playerController->GetMousePosition(mousePosition.X, mousePosition.Y)
+		&& ProjectPointerToPlane(playerController, mousePosition, OutPointerLocation);
+}
 
-		const FVector actorLocation = GetActorLocation();
-		const FVector spotLightDirection = UKismetMathLibrary::GetDirectionUnitVector(FVector(0, actorLocation.Y, actorLocation.Z), FVector(0, mouseWorldLocation.Y, mouseWorldLocation.Z));
-		SetTracerRotation(spotLightDirection);
-		
-		return true;
-	}
-	return false;
+bool ATheLighterBall::ProjectPointerToPlane(APlayerController* playerController, const FVector2D& ViewportPosition, FVector& OutPointerLocation) const
+{
+	FVector rayOrigin;
+	FVector rayDirection;
+	if (!playerController->DeprojectScreenPositionToWorld(ViewportPosition.X, ViewportPosition.Y, rayOrigin, rayDirection))
+		return false;
+
+	// The camera looks straight down X at the PlayerBall, so this practically never misses
+	// Fallback is the old fixed-distance point (SpringArm length along the ray)
+	if (!IntersectLighterPlane(rayOrigin, rayDirection, GetActorLocation().X, OutPointerLocation))
+		OutPointerLocation = rayOrigin + rayDirection * SpringArm->TargetArmLength;
+
+	return true;
+}
+
+// Shared by the live mouse & replays
+void ATheLighterBall::PointTracerAt(const FVector& PointerLocation)
+{
+	LastPointerLocation = PointerLocation;
+
+	const FVector actorLocation = GetActorLocation();
+	const FVector spotLightDirection = UKismetMathLibrary::GetDirectionUnitVector(FVector(0, actorLocation.Y, actorLocation.Z), FVector(0, PointerLocation.Y, PointerLocation.Z));
+	SetTracerRotation(spotLightDirection);
 }
 
 
@@ -535,17 +1194,33 @@ bool ATheLighterBall::QueryMouseInput(APlayerController* playerController)
 // Query any GamePads for input
 // Feed the right stick direction to the inputs
 
-void ATheLighterBall::PointRight(float Val) { InputGamepadRX = Val; }
-void ATheLighterBall::PointUp(float Val) { InputGamepadRY = Val; }
+// Either axis changing is a new sample (One trace a frame, whichever came first)
+
+void ATheLighterBall::PointRight(float Val)
+{
+	if (IsReplayingInput()) return;
 
+	if (Val != PendingInput.PointRight && GamepadTrace == 0)
+		GamepadTrace = BeginInputTrace(ELighterInputSource::Gamepad, GetInputArrivalTime(TEXT("PointRight"), true));
+	PendingInput.PointRight = Val;
+}
 
-bool ATheLighterBall::QueryGamepadInput(APlayerController* playerController)
+void ATheLighterBall::PointUp(float Val)
 {
-	if (fabs(InputGamepadRX) < GamepadInputThreshold && fabs(InputGamepadRY) < GamepadInputThreshold)
+	if (IsReplayingInput()) return;
+
+	if (Val != PendingInput.PointUp && GamepadTrace == 0)
+		GamepadTrace = BeginInputTrace(ELighterInputSource::Gamepad, GetInputArrivalTime(TEXT("PointUp"), true));
+	PendingInput.PointUp = Val;
+}
+
+
+bool ATheLighterBall::QueryGamepadInput()
+{
+	if (fabs(PendingInput.PointRight) < GamepadInputThreshold && fabs(PendingInput.PointUp) < GamepadInputThreshold)
 		return false;
 	
-	const FVector actorLocation = GetActorLocation();
-	const FVector spotLightDirection = FVector(0, InputGamepadRX, InputGamepadRY);
+	const FVector spotLightDirection = FVector(0, PendingInput.PointRight, PendingInput.PointUp);
 	SetTracerRotation(spotLightDirection);
 	
 	return true;
@@ -557,7 +1232,8 @@ void ATheLighterBall::DetachPlayerBall()
 	bDisableAirControl = true;
 	bDisableJump = true;
 
-	GetWorld()->GetFirstPlayerController()->bShowMouseCursor = true;
+	if (APlayerController* playerController = Cast<APlayerController>(GetController()))
+		playerController->bShowMouseCursor = true;
 }
 ////////////////////////////////////////////////// Tracer Control
 
@@ -568,31 +1244,374 @@ void ATheLighterBall::DetachPlayerBall()
 
 
 
+////////////////////////////////////////////////// Input Frame
+void ATheLighterBall::GatherInput(APlayerController* playerController, const float DeltaSeconds)
+{
+	if (InputMode == ELighterInputMode::Replaying)
+	{
+		PendingInput = InputRecording->Frames[ReplayFrame];
+		if (PointerInput.IsValid())
+			PointerInput->ResetSamples();
+		return;
+	}
+
+	// The axis & action bindings have already filled in the rest
+	PendingInput.DeltaSeconds = DeltaSeconds;
+	PendingInput.bPointerMoved = false;
+	// Only our own player's cursor (A listen server also holds the remote players' controllers)
+	if (!bDisableTracerControl && playerController && playerController->IsLocalController())
+	{
+		LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterInputQueries);
+		PendingInput.bPointerMoved = QueryMouseInput(playerController, PendingInput.PointerLocation);
+		if (PendingInput.bPointerMoved)
+			PointerTrace = BeginInputTrace(ELighterInputSource::Pointer, FirstPointerSampleTime);
+	}
+	else if (PointerInput.IsValid())
+		PointerInput->ResetSamples();
+}
+
+void ATheLighterBall::ApplyInput()
+{
+	ApplyMoveRight(PendingInput.MoveRight);
+	if (PendingInput.bJump)
+		ApplyJump();
+
+	// Mouse first, the gamepad wins if both moved
+	if (!bDisableTracerControl)
+	{
+		if (PendingInput.bPointerMoved)
+		{
+			PointTracerAt(PendingInput.PointerLocation);
+			MarkAimApplied(PointerTrace);
+		}
+		if (QueryGamepadInput())
+			MarkAimApplied(GamepadTrace);
+	}
+
+	// Samples nothing acted on (Disabled input, jumping mid-air) end here
+	MoveRightTrace = JumpTrace = PointerTrace = GamepadTrace = 0;
+}
+
+void ATheLighterBall::FinishInputFrame()
+{
+	PendingInput.BallLocation = GetActorLocation();
+	const FLighterBlockSet* litSet = GetLitSet();
+	PendingInput.LitSetHash = litSet ? litSet->GetHash() : 0;
+
+	if (InputMode == ELighterInputMode::Recording)
+		InputRecording->Frames.Add(PendingInput);
+	else if (InputMode == ELighterInputMode::Replaying)
+	{
+		// Same input, same frame time => Same trajectory & same LitSet
+		const FLighterInputFrame& recordedFrame = InputRecording->Frames[ReplayFrame];
+		if (!recordedFrame.BallLocation.Equals(PendingInput.BallLocation, 0.1f) || recordedFrame.LitSetHash != PendingInput.LitSetHash)
+			if (ReplayDivergedFrames++ == 0)
+				UE_LOG(LogTheLighter, Warning, TEXT("Replay %s diverged at frame %d (Ball %s, expected %s)"),
+					*ReplayName, ReplayFrame, *PendingInput.BallLocation.ToString(), *recordedFrame.BallLocation.ToString());
+
+		if (++ReplayFrame < InputRecording->Frames.Num())
+			FApp::SetFixedDeltaTime(InputRecording->Frames[ReplayFrame].DeltaSeconds);
+		else
+			StopInputReplay();
+	}
+
+	// Actions only last one frame
+	PendingInput.bJump = false;
+}
+////////////////////////////////////////////////// Input Frame
+
+
+
+
+
+
+
+////////////////////////////////////////////////// Input Latency
+FLighterInputLatency* ATheLighterBall::GetInputLatency() const
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	return subsystem ? &subsystem->GetInputLatency() : nullptr;
+}
+
+uint32 ATheLighterBall::BeginInputTrace(const ELighterInputSource Source, const double ArrivalTime) const
+{
+	FLighterInputLatency* latency = GetInputLatency();
+	return latency ? latency->Begin(Source, ArrivalTime) : 0;
+}
+
+double ATheLighterBall::GetInputArrivalTime(const FName Binding, const bool bAxis) const
+{
+	const double now = FPlatformTime::Seconds();
+	const APlayerController* playerController = Cast<APlayerController>(GetController());
+	if (!PointerInput.IsValid() || !playerController || !playerController->PlayerInput || !FLighterInputLatency::IsEnabled())
+		return now;
+
+	double arrivalTime = 0.0;
+	if (bAxis)
+	{
+		for (const FInputAxisKeyMapping& mapping : playerController->PlayerInput->GetKeysForAxis(Binding))
+			arrivalTime = FMath::Max(arrivalTime, PointerInput->GetKeyTime(mapping.Key));
+	}
+	else
+	{
+		for (const FInputActionKeyMapping& mapping : playerController->PlayerInput->GetKeysForAction(Binding))
+			arrivalTime = FMath::Max(arrivalTime, PointerInput->GetKeyTime(mapping.Key));
+	}
+
+	// No event came through Slate for it (Or only a stale one) => When the binding fired
+	return arrivalTime > 0.0 && (now - arrivalTime) * 1000.0 <= FLighterInputLatency::MaxTraceMs ? arrivalTime : now;
+}
+
+void ATheLighterBall::MarkInputApplied(uint32& Trace, const bool bSimulated)
+{
+	if (Trace == 0) return;
+
+	if (FLighterInputLatency* latency = GetInputLatency())
+	{
+		latency->Reach(Trace, ELighterLatencyStage::Applied, FPlatformTime::Seconds());
+		if (bSimulated)
+			latency->ReachOnPhysicsStep(Trace);
+	}
+	Trace = 0;
+}
+
+void ATheLighterBall::MarkAimApplied(uint32& Trace)
+{
+	if (Trace == 0) return;
+
+	AimTrace = Trace;
+	MarkInputApplied(Trace, false);
+}
+////////////////////////////////////////////////// Input Latency
+
+
+
+
+
+
+
+////////////////////////////////////////////////// Input Recording & Replay
+void ATheLighterBall::StartInputRecording()
+{
+	if (InputMode != ELighterInputMode::Live) return;
+
+	InputRecording = MakeShared<FLighterInputRecording>();
+	InputRecording->MapName = GetWorld()->GetMapName();
+	InputRecording->StartTransform = GetActorTransform();
+	InputRecording->StartLinearVelocity = Ball->GetPhysicsLinearVelocity();
+	InputRecording->StartAngularVelocity = Ball->GetPhysicsAngularVelocityInDegrees();
+	InputRecording->StartTracerRotation = SpotLight->GetComponentRotation();
+	InputRecording->StartTargetTracerRotation = TargetTracerRotation;
+
+	InputMode = ELighterInputMode::Recording;
+	UE_LOG(LogTheLighter, Log, TEXT("Recording PlayerBall input"));
+}
+
+bool ATheLighterBall::StopInputRecording(const FString& Name)
+{
+	if (InputMode != ELighterInputMode::Recording) return false;
+	InputMode = ELighterInputMode::Live;
+
+	const FString path = FLighterInputRecording::GetRecordingPath(Name);
+	const bool bSaved = InputRecording->SaveToFile(path);
+	UE_LOG(LogTheLighter, Log, TEXT("%s %d recorded frames to %s"), bSaved ? TEXT("Saved") : TEXT("FAILED to save"), InputRecording->Frames.Num(), *path);
+
+	InputRecording.Reset();
+	return bSaved;
+}
+
+bool ATheLighterBall::StartInputReplay(const FString& Name, const bool bQuitWhenDone)
+{
+	if (InputMode != ELighterInputMode::Live) return false;
+
+	TSharedPtr<FLighterInputRecording> recording = MakeShared<FLighterInputRecording>();
+	if (!recording->LoadFromFile(FLighterInputRecording::GetRecordingPath(Name)) || recording->Frames.Num() == 0)
+	{
+		UE_LOG(LogTheLighter, Error, TEXT("Couldn't load recording %s"), *Name);
+		return false;
+	}
+
+	if (recording->MapName != GetWorld()->GetMapName())
+		UE_LOG(LogTheLighter, Warning, TEXT("Recording %s was made on %s, replaying on %s"), *Name, *recording->MapName, *GetWorld()->GetMapName());
+
+	// Put the PlayerBall back where the session started
+	SetActorTransform(recording->StartTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	Ball->SetPhysicsLinearVelocity(recording->StartLinearVelocity);
+	Ball->SetPhysicsAngularVelocityInDegrees(recording->StartAngularVelocity);
+	SpotLight->SetWorldRotation(recording->StartTracerRotation);
+	TargetTracerRotation = recording->StartTargetTracerRotation;
+
+	// FIXED timestep => Every frame gets its recorded DeltaSeconds & the engine never waits on the clock
+	bWasUsingFixedTimeStep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(recording->Frames[0].DeltaSeconds);
+
+	InputRecording = recording;
+	InputMode = ELighterInputMode::Replaying;
+	ReplayName = Name;
+	ReplayFrame = 0;
+	ReplayDivergedFrames = 0;
+	bQuitWhenReplayDone = bQuitWhenDone;
+	ReplayStartTime = FPlatformTime::Seconds();
+
+#if CSV_PROFILER
+	// Frame-time profile of the whole replay => Diff it between builds
+	if (FCsvProfiler* csvProfiler = FCsvProfiler::Get())
+		csvProfiler->BeginCapture(-1, FString(), FString::Printf(TEXT("Replay-%s.csv"), *Name));
+#endif
+
+	UE_LOG(LogTheLighter, Log, TEXT("Replaying %s (%d frames)"), *Name, recording->Frames.Num());
+	return true;
+}
+
+void ATheLighterBall::StopInputReplay()
+{
+	if (InputMode != ELighterInputMode::Replaying) return;
+
+#if CSV_PROFILER
+	if (FCsvProfiler* csvProfiler = FCsvProfiler::Get())
+		csvProfiler->EndCapture();
+#endif
+
+	const double wallSeconds = FPlatformTime::Seconds() - ReplayStartTime;
+	UE_LOG(LogTheLighter, Log, TEXT("Replay %s: %d / %d frames in %.2fs (%.3f ms/frame), %d diverged frames"),
+		*ReplayName, ReplayFrame, InputRecording->Frames.Num(), wallSeconds, wallSeconds * 1000.0 / FMath::Max(1, ReplayFrame), ReplayDivergedFrames);
+
+	FApp::SetUseFixedTimeStep(bWasUsingFixedTimeStep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+
+	InputMode = ELighterInputMode::Live;
+	InputRecording.Reset();
+	PendingInput = FLighterInputFrame();
+
+	if (bQuitWhenReplayDone && GEngine)
+		GEngine->DeferredCommands.Add(TEXT("quit"));
+}
+////////////////////////////////////////////////// Input Recording & Replay
+
+
+
+
+
+
+
 ////////////////////////////////////////////////// Exit Impulse
 void ATheLighterBall::ApplyExitImpulse()
 {
+	// Overlap order inside a booster chain is up to physics
+	// So nothing gets applied here, the exits are just counted
+	++PendingExits;
+}
+
+void ATheLighterBall::ResolveExitImpulses()
+{
+	if (PendingExits == 0) return;
+	LIGHTER_SCOPE_CYCLE_COUNTER(STAT_LighterApplyExitImpulse);
+	LIGHTER_INC_COUNTER(STAT_LighterExitImpulses, PendingExits);
+
+	const int32 exitCount = PendingExits;
+	PendingExits = 0;
+
 	const FVector ballVelocity = GetVelocity();
 	const FVector spotLightDirection = SpotLight->GetForwardVector() * -1;
-	const float angle = FMath::Acos(FVector::DotProduct(ballVelocity.GetSafeNormal(), spotLightDirection));
 
-	const float multiplier = ExitImpulse * ImpulseMultiplier;
+	// Every exit of the frame sees the same velocity, so N exits => N times the boost, applied once
+	const float multiplier = ExitImpulse * ImpulseMultiplier * exitCount;
 	const FVector velocityBoost = ballVelocity.GetSafeNormal() * multiplier;
 	const FVector spotlightBoost = spotLightDirection * multiplier;
 
 	if (!bDisableExitImpulse)
 		Ball->AddImpulse(velocityBoost * ExitImpulseRatio + spotlightBoost * (1 - ExitImpulseRatio));
-		
 
-	
 	if (ballVelocity.Size() > MaxExitVelocity)
 		Ball->SetPhysicsLinearVelocity(ballVelocity.GetSafeNormal() * MaxExitVelocity);
 
+	SpawnEffect(ExitImpulseEffect, ballVelocity.Rotation());
 	OnExitImpulse.Broadcast();
+	OnExitImpulseBatch.Broadcast(exitCount);
+}
+
+void ATheLighterBall::SpawnEffect(UParticleSystem* Template, const FRotator& Rotation) const
+{
+	if (!Template) return;
+	if (ULighterEffectSubsystem* effects = GetWorld()->GetSubsystem<ULighterEffectSubsystem>())
+		effects->SpawnEffect(Template, GetActorLocation(), Rotation);
 }
 ////////////////////////////////////////////////// Exit Impulse
 
 
 
+
+
+
+
+////////////////////////////////////////////////// Checkpoints
+void ATheLighterBall::SaveCheckpoint()
+{
+	if (ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>())
+		subsystem->SaveCheckpoint();
+}
+
+bool ATheLighterBall::LoadCheckpoint()
+{
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	return subsystem && subsystem->LoadCheckpoint();
+}
+
+void ATheLighterBall::CaptureSnapshot(FLighterBallSnapshot& OutSnapshot) const
+{
+	OutSnapshot.Ball = const_cast<ATheLighterBall*>(this);
+	OutSnapshot.Transform = Ball->GetComponentTransform();
+	OutSnapshot.LinearVelocity = Ball->GetPhysicsLinearVelocity();
+	OutSnapshot.AngularVelocity = Ball->GetPhysicsAngularVelocityInDegrees();
+	OutSnapshot.GroundedTime = GroundedTime;
+	OutSnapshot.CurrentTracerRotation = SpotLight->GetComponentRotation();
+	OutSnapshot.TargetTracerRotation = TargetTracerRotation;
+	OutSnapshot.TracerMode = (uint8)TracerMode;
+
+	OutSnapshot.Flags =
+		(bDisableTracerControl	? FLighterBallSnapshot::DisableTracerControl : 0) |
+		(bDisableMovement		? FLighterBallSnapshot::DisableMovement : 0) |
+		(bDisableAirControl		? FLighterBallSnapshot::DisableAirControl : 0) |
+		(bDisableJump			? FLighterBallSnapshot::DisableJump : 0) |
+		(bDisableExitImpulse	? FLighterBallSnapshot::DisableExitImpulse : 0) |
+		(bIsGrounded			? FLighterBallSnapshot::Grounded : 0) |
+		(bIsWalled				? FLighterBallSnapshot::Walled : 0);
+}
+
+void ATheLighterBall::RestoreSnapshot(const FLighterBallSnapshot& Snapshot)
+{
+	// Teleport => No sweep & the body's velocities start over, then get theirs back
+	SetActorTransform(Snapshot.Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Ball->SetPhysicsLinearVelocity(Snapshot.LinearVelocity);
+	Ball->SetPhysicsAngularVelocityInDegrees(Snapshot.AngularVelocity);
+
+	GroundedTime = Snapshot.GroundedTime;
+	SpotLight->SetWorldRotation(Snapshot.CurrentTracerRotation);
+	CurrentTracerRotation = Snapshot.CurrentTracerRotation;
+	TargetTracerRotation = Snapshot.TargetTracerRotation;
+	LastTargetRotation = Snapshot.TargetTracerRotation;
+	TracerMode = (ETracerMode)Snapshot.TracerMode;
+
+	bDisableTracerControl	= (Snapshot.Flags & FLighterBallSnapshot::DisableTracerControl) != 0;
+	bDisableMovement		= (Snapshot.Flags & FLighterBallSnapshot::DisableMovement) != 0;
+	bDisableAirControl		= (Snapshot.Flags & FLighterBallSnapshot::DisableAirControl) != 0;
+	bDisableJump			= (Snapshot.Flags & FLighterBallSnapshot::DisableJump) != 0;
+	bDisableExitImpulse		= (Snapshot.Flags & FLighterBallSnapshot::DisableExitImpulse) != 0;
+	bIsGrounded				= (Snapshot.Flags & FLighterBallSnapshot::Grounded) != 0;
+	bIsWalled				= (Snapshot.Flags & FLighterBallSnapshot::Walled) != 0;
+
+	// Nothing from before the restore may land after it
+	PendingExits = 0;
+	bHasAsyncResults = false;
+	++AsyncProbeBatch;
+	ResetContacts();
+}
+////////////////////////////////////////////////// Checkpoints
+
+
+
 #pragma endregion INPUTS AND MOVEMENT
 ////////////////////////////////////////////////////////////////////// INPUTS & MOVEMENT
 
@@ -611,11 +1630,220 @@ void ATheLighterBall::ApplyExitImpulse()
 
 
 
+////////////////////////////////////////////////////////////////////// NETWORK
+#pragma region NETWORK
+/*
+* The owning client moves its own ball (Physics & input stay local, no round trip before it reacts)
+* 		1. Owner	=> Location, velocity & TargetTracerRotation to the server, unreliable & rate-capped
+* 		2. Server	=> Puts its copy there & traces with it, so the lit state it replicates includes that player
+* 		3. Others	=> Replicated movement & TargetTracerRotation, their own Tick lerps the SpotLight
+* 					   Their copy never traces or prelights (IsTracedLocally), the lit state comes from the server
+*
+* ReplicatedMovement reaches the owner too, but it's the server echoing what the owner sent => Dropped there
+* Otherwise it drags the local sim back to where it was a round trip ago (Rubber-banding)
+*
+* NOTE: Trusts the owner, it's co-op
+*/
+
+void ATheLighterBall::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// The owner already knows, Current changes every frame the SpotLight lerps so it's only sent once
+	DOREPLIFETIME_CONDITION(ATheLighterBall, TargetTracerRotation, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(ATheLighterBall, CurrentTracerRotation, COND_InitialOnly);
+}
+
+void ATheLighterBall::OnRep_ReplicatedMovement()
+{
+	if (IsLocallyControlled()) return;
+	Super::OnRep_ReplicatedMovement();
+}
+
+void ATheLighterBall::SendOwnerState()
+{
+	const float rate = CVarLighterNetOwnerStateRate.GetValueOnGameThread();
+	const double now = FPlatformTime::Seconds();
+	if (rate <= 0.f || now - LastOwnerStateTime < 1.0 / rate) return;
+	LastOwnerStateTime = now;
+
+	FLighterNetBallState state;
+	state.Location = GetActorLocation();
+	state.Velocity = Ball->GetPhysicsLinearVelocity();
+	state.TargetTracerRotation = TargetTracerRotation;
+	ServerUpdateOwnerState(state);
+}
+
+void ATheLighterBall::ServerUpdateOwnerState_Implementation(const FLighterNetBallState& State)
+{
+	SetActorLocation(State.Location, false, nullptr, ETeleportType::TeleportPhysics);
+	Ball->SetPhysicsLinearVelocity(State.Velocity);
+	TargetTracerRotation = State.TargetTracerRotation;
+	LastTargetRotation = State.TargetTracerRotation;
+}
+
+void ATheLighterBall::OnRep_CurrentTracerRotation()
+{
+	SpotLight->SetWorldRotation(CurrentTracerRotation);
+}
+#pragma endregion NETWORK
+////////////////////////////////////////////////////////////////////// NETWORK
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
 ////////////////////////////////////////////////////////////////////// COLLISION
 #pragma region COLLISION
+// ABlockField instances can't tell which instance the ball left (OtherBodyIndex is OUR body)
+// But the ball can, so it reports it back to the field
+
+void ATheLighterBall::OnBallEndOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	if (ABlockField* blockField = Cast<ABlockField>(OtherActor))
+		blockField->OnInstanceEndOverlap(OtherBodyIndex, this);
+}
+
 void ATheLighterBall::NotifyHit(class UPrimitiveComponent* MyComp, class AActor* Other, class UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit)
 {
 	Super::NotifyHit(MyComp, Other, OtherComp, bSelfMoved, HitLocation, HitNormal, NormalImpulse, Hit);
+
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	const int32 blockIndex = subsystem ? subsystem->GetBlockIndexFromHit(Hit) : INDEX_NONE;
+
+	// Ground & walls (See CONTACTS)
+	RecordContact(OtherComp, blockIndex, HitNormal);
+
+	// Touching a block our own aim made solid => That input's CONTACT (See LighterInputLatency.h)
+	if (!FLighterInputLatency::IsEnabled()) return;
+
+	const FLighterBlockSet* litSet = GetLitSet();
+	if (blockIndex != INDEX_NONE && litSet && litSet->Contains(blockIndex))
+		subsystem->GetInputLatency().Reach(subsystem->GetBlockInputTrace(blockIndex), ELighterLatencyStage::Contact, FPlatformTime::Seconds());
+}
+
+
+
+/*
+* CONTACTS
+* --------
+* Physics already tells us everything the ball touches, every step it touches it (NotifyHit)
+* 		Normal up to MaxGroundSlopeAngle	=> Ground
+* 		Steeper, but not a ceiling			=> Wall, on the side the normal points away from
+*
+* The last few contacts are cached & re-evaluated once a frame in Tick
+* 		Not reported for Lighter.ContactGrace	=> Gone (Bounces & block seams break contact for a step or two, no flicker)
+* 		LighterBlock no longer solid			=> Gone right away, we're about to fall through it
+* 		Ball asleep								=> Nothing gets reported, but nothing moved either => Kept
+*
+* The Grounding & Walling rays are only the fallback now
+* 		Lighter.ContactGrounding 0, no hit events on the body, or the first frame after a spawn / restore
+* No probing from fixed offsets => No more losing the ground on slopes between the two rays
+*/
+
+void ATheLighterBall::RecordContact(UPrimitiveComponent* Component, const int32 BlockIndex, const FVector& Normal)
+{
+	if (!Component) return;
+
+	const float now = GetWorld()->GetTimeSeconds();
+	int32 oldest = 0;
+	for (int32 i = 0; i < Contacts.Num(); ++i)
+	{
+		FBallContact& contact = Contacts[i];
+		if (contact.Component.Get() == Component && contact.BlockIndex == BlockIndex)
+		{
+			contact.Normal = Normal;
+			contact.Time = now;
+			return;
+		}
+		if (contact.Time < Contacts[oldest].Time)
+			oldest = i;
+	}
+
+	// Full => The one that's gone longest without a report makes room
+	FBallContact& contact = Contacts.Num() < MaxContacts ? Contacts.AddDefaulted_GetRef() : Contacts[oldest];
+	contact.Component = Component;
+	contact.BlockIndex = BlockIndex;
+	contact.Normal = Normal;
+	contact.Time = now;
+}
+
+bool ATheLighterBall::IsContactBlocking(const FBallContact& Contact) const
+{
+	const UPrimitiveComponent* component = Contact.Component.Get();
+	if (!component) return false;
+
+	if (Contact.BlockIndex != INDEX_NONE)
+	{
+		const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+		return subsystem && subsystem->IsBlockSolid(Contact.BlockIndex);
+	}
+
+	return component->IsCollisionEnabled() && component->GetCollisionResponseToChannel(Ball->GetCollisionObjectType()) == ECR_Block;
+}
+
+bool ATheLighterBall::UpdateContactState()
+{
+	if (CVarLighterContactGrounding.GetValueOnGameThread() == 0 || !Ball->BodyInstance.bNotifyRigidBodyCollision)
+		return false;
+
+	if (bContactsReset)
+	{
+		bContactsReset = false;
+		return false;
+	}
+
+	const float now = GetWorld()->GetTimeSeconds();
+	const float grace = FMath::Max(0.f, CVarLighterContactGrace.GetValueOnGameThread());
+	const bool bAsleep = !Ball->RigidBodyIsAwake();
+	const float minGroundZ = FMath::Cos(FMath::DegreesToRadians(MaxGroundSlopeAngle));
+
+	bool bGrounded = false;
+	bool bWallLeft = false;
+	bool bWallRight = false;
+	for (int32 i = Contacts.Num() - 1; i >= 0; --i)
+	{
+		const FBallContact& contact = Contacts[i];
+		if ((!bAsleep && now - contact.Time > grace) || !IsContactBlocking(contact))
+		{
+			Contacts.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (contact.Normal.Z >= minGroundZ)
+			bGrounded |= contact.Time > LastJumpTime;
+		else if (contact.Normal.Z > -minGroundZ)
+		{
+			// A wall on our right pushes us left
+			if (contact.Normal.Y < 0.f)
+				bWallRight = true;
+			else
+				bWallLeft = true;
+		}
+	}
+
+	bIsGrounded = bGrounded;
+	WalledDirection = bWallLeft && bWallRight ? WallingDirection::Both : bWallLeft ? WallingDirection::Left : bWallRight ? WallingDirection::Right : WallingDirection::None;
+	bIsWalled = WalledDirection != WallingDirection::None;
+	return true;
+}
+
+void ATheLighterBall::ResetContacts()
+{
+	Contacts.Reset();
+	LastJumpTime = -1.f;
+	bContactsReset = true;
 }
 #pragma endregion COLLISION
 ////////////////////////////////////////////////////////////////////// COLLISION
\ No newline at end of file
@@ -5,6 +5,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Pawn.h"
+#include "WorldCollision.h"
+#include "Engine/NetSerialization.h"
+#include "LighterBlockSet.h"
+#include "LighterVisibility.h"
+#include "LighterInputRecording.h"
+#include "LighterPointerInput.h"
+#include "LighterInputLatency.h"
 #include "TheLighterBall.generated.h"
 
 
@@ -12,6 +19,7 @@
 // This is because I want to do particle emissions on the blueprint side to keep things clean
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDoubleJumpDelegate);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FExitImpulseDelegate);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FExitImpulseBatchDelegate, int32, ExitCount);
 
 
 // Used for climb prevention due to high friction
@@ -25,6 +33,42 @@ enum WallingDirection
 };
 
 
+// How the Tracer finds the LighterBlocks inside the SpotLight's cone
+UENUM()
+enum class ETracerMode : uint8
+{
+	RayFan,			// NumberOfTraces LineTraces spread across the cone
+	ConeQuery,		// Exact cone-vs-block test against the LighterBlockGrid (No rays)
+	Visibility		// Exact visibility polygon => Only the blocks the light actually reaches (Blocks occlude each other)
+};
+
+
+// Where the PlayerBall's input comes from this frame
+enum class ELighterInputMode : uint8
+{
+	Live,			// Bindings & mouse
+	Recording,		// Bindings & mouse, every frame gets saved
+	Replaying		// Frames from a FLighterInputRecording, live input is ignored
+};
+
+
+// What the owning client sends the server about its own ball (See NETWORK)
+USTRUCT()
+struct FLighterNetBallState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		FVector_NetQuantize10 Location;
+
+	UPROPERTY()
+		FVector_NetQuantize10 Velocity;
+
+	UPROPERTY()
+		FRotator TargetTracerRotation;
+};
+
+
 
 
 ////////////////////////////////////////////////////////////////////// CORE
@@ -33,6 +77,12 @@ class ATheLighterBall : public APawn
 {
 	GENERATED_BODY()
 
+	// Drives the Tracer stages one by one (Tools/LighterBenchmark.cpp)
+	friend class FLighterBenchmark;
+
+	// Fires the ball at blocks on its own (Tools/LighterSubstepDebug.cpp)
+	friend class FLighterTunnelTest;
+
 #pragma region CORE COMPONENTS
 
 	// Using the Ball preset from StarterContent
@@ -175,6 +225,10 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "////////// 3. Movement")
 		bool bIsWalled = false;
 
+	// Steepest contact that still counts as ground (Degrees), anything steeper is a wall
+	UPROPERTY(EditAnywhere, Category = "////////// 3. Movement", meta = (ClampMin = "0.0", ClampMax = "89.0"))
+		float MaxGroundSlopeAngle = 50.f;
+
 	// Set velocity for a consistent jump
 	UPROPERTY(EditAnywhere, Category = "////////// 3. Movement", meta = (ClampMin = "0.0"))
 		float BaseJumpVelocity;
@@ -199,14 +253,24 @@ public:
 
 
 	// Exit Impulse is the impulse that's applied when the PlayerBall gets out of a LighterBlock mesh
+	// Only QUEUES the exit, every exit of the frame gets resolved at once (See ResolveExitImpulses)
 	UFUNCTION(BlueprintCallable, Category = "////////// 3. Movement")
 		void ApplyExitImpulse();
 
+	// ONE combined impulse, ONE MaxExitVelocity clamp & ONE event for every exit queued since the last call
+	// The LighterBlockSubsystem calls it once per frame, after physics
+	void ResolveExitImpulses();
+
+	FORCEINLINE int32 GetNumPendingExits() const { return PendingExits; }
+
 
 private:
 	FRotator LastTargetRotation;
 	float ForceMultiplier = 1000000.f;
 	float ImpulseMultiplier = 1000.f;
+
+	// Exits queued by the LighterBlocks since the last ResolveExitImpulses
+	int32 PendingExits = 0;
 #pragma endregion
 ////////////////////////////////////////////////////////////////////// MOVEMENT CONFIG
 
@@ -216,6 +280,88 @@ private:
 
 
 
+
+////////////////////////////////////////////////////////////////////// EFFECTS
+// Spawned natively from the ULighterEffectSubsystem's pools (The events still fire for anything else on the blueprint side)
+#pragma region EFFECTS
+public:
+	// Particles on a DoubleJump
+	UPROPERTY(EditAnywhere, Category = "////////// 5. Effects")
+		class UParticleSystem* DoubleJumpEffect = nullptr;
+
+	// Particles on a frame's ExitImpulse (Once per frame, however many blocks were exited)
+	UPROPERTY(EditAnywhere, Category = "////////// 5. Effects")
+		class UParticleSystem* ExitImpulseEffect = nullptr;
+
+private:
+	void SpawnEffect(class UParticleSystem* Template, const FRotator& Rotation = FRotator::ZeroRotator) const;
+#pragma endregion
+////////////////////////////////////////////////////////////////////// EFFECTS
+
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// CHECKPOINTS
+// Respawn without reloading anything (See LighterCheckpoint.h)
+#pragma region CHECKPOINTS
+public:
+	// Blocks, emitters & every ball, as they are right now
+	UFUNCTION(BlueprintCallable, Category = "////////// 2. Mode")
+		void SaveCheckpoint();
+
+	// Back to the last SaveCheckpoint (False if there's none)
+	UFUNCTION(BlueprintCallable, Category = "////////// 2. Mode")
+		bool LoadCheckpoint();
+
+	// This ball's share of a checkpoint
+	void CaptureSnapshot(struct FLighterBallSnapshot& OutSnapshot) const;
+	void RestoreSnapshot(const struct FLighterBallSnapshot& Snapshot);
+#pragma endregion
+////////////////////////////////////////////////////////////////////// CHECKPOINTS
+
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// NETWORK
+// Co-op => Each client owns its ball, the server follows it & lights the blocks for everyone
+#pragma region NETWORK
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Ignored on our own ball, the local sim is the truth there
+	virtual void OnRep_ReplicatedMovement() override;
+
+	// Another player's ball on our client => The server lights the blocks for it, we don't trace or prelight
+	FORCEINLINE bool IsTracedLocally() const { return GetLocalRole() != ROLE_SimulatedProxy; }
+
+private:
+	// Owning client => Server, at most Lighter.Net.OwnerStateRate times a second
+	void SendOwnerState();
+
+	UFUNCTION(Server, Unreliable)
+		void ServerUpdateOwnerState(const FLighterNetBallState& State);
+
+	UFUNCTION()
+		void OnRep_CurrentTracerRotation();
+
+	double LastOwnerStateTime = 0.0;
+#pragma endregion
+////////////////////////////////////////////////////////////////////// NETWORK
+
+
+
+
+
+
+
 	
 
 ////////////////////////////////////////////////////////////////////// TRACER
@@ -226,6 +372,16 @@ private:
 #pragma region TRACER
 	float TraceAngle = 45.f;
 
+	// RayFan is the classic tracer, ConeQuery never misses blocks that fall between rays
+	// Visibility is the ConeQuery with occlusion, so it matches what the RayFan's rays could ever hit
+	UPROPERTY(EditAnywhere, Category = "////////// 4. Tracer")
+		ETracerMode TracerMode = ETracerMode::RayFan;
+
+	// Submit the Tracer & Grounding rays as one async batch and use the results NEXT frame
+	// Takes the scene queries off the game thread, at the cost of one frame of latency
+	UPROPERTY(EditAnywhere, Category = "////////// 4. Tracer")
+		bool bAsyncProbes = false;
+
 	// Number of LineTraceByChannels
 	UPROPERTY(EditAnywhere, Category = "////////// 4. Tracer", meta = (ClampMin = "0", ClampMax = "8"))
 		int NumberOfTraces = 2;
@@ -258,6 +414,13 @@ private:
 
 
 
+	// PRE-LIGHTING (See LighterBlockSubsystem.h)
+public:
+	// Stage the blocks the cone reaches over the next Frames frames
+	// The LighterBlockSubsystem calls it for every ball at once, right before physics
+	void StagePrelight(const int32 Frames);
+
+private:
 	// Functions to SMOOTHLY LERP the Flashlight in the intended direction
 	void SetTracerRotation(const FVector Direction);				// Set target flashlight rotation
 	void LerpTracerToTargetRotation(const float DeltaSeconds);		// Rotate flashlight smoothly
@@ -269,13 +432,70 @@ private:
 	// This is the set of DATA STRUCTURES
 	// That help drive our TRACER ALGORITHM - To help query & store ACTIVELY LIT LighterBlocks
 
-	TArray<class ABlock*> LitSet;
+	// The LITSET lives in the LighterBlockSubsystem, as this ball's EMITTER
+	// Lit counts are shared, so other balls & lamps lighting the same block never fight over it
+
+	int32 EmitterId = INDEX_NONE;									// Emitter slot in the LighterBlockSubsystem
+	FLighterBlockSet HitSet;										// Blocks hit this frame (Reused every frame)
+	TArray<int32> TraceScratch;										// Reused query output
+	TArray<FBox2D> BoundsScratch;									// Reused visibility input
+	TArray<int32> VisibleScratch;									// Reused visibility output
+	TArray<FVector2D> PolygonScratch;								// Reused visibility polygon (Debug only)
+	FLighterVisibility Visibility;
+	TArray<FLighterCone> PrelightCones;								// Reused predicted cones
+
 	void TraceCollision();											// Fire traces to check LighterBlocks
-	inline bool SetAdd(TArray<ABlock*> &arrayRef, class ABlock * actorRef, const bool bCollisionToggle);		// Data structure to handle active LighterBLocks
-	inline bool SetRemove(TArray<ABlock*>& arrayRef, class ABlock * actorRef, const bool bCollisionToggle);		// Data structure to handle active LighterBLocks
+	void TraceHitSet(FLighterBlockSet& hitSet);						// Populate the HITSET with the current TracerMode
+	void TraceRayFan(FLighterBlockSet& hitSet);						// Populate the HITSET with LineTraces
+	void TraceCone(FLighterBlockSet& hitSet);						// Populate the HITSET with the exact cone query
+	void TraceVisibility(FLighterBlockSet& hitSet);					// Populate the HITSET with the exact visibility polygon
+	FLighterCone GetTracerCone() const;								// The SpotLight's cone on the YZ plane
+	FLighterCone GetTracerCone(const FVector& Location, const FVector& Direction) const;
+	FVector GetPredictedAcceleration() const;						// Gravity (If it's on) & our own gravity correction
+	void UpdateLitSet();											// Hand the HITSET to our emitter (Diff & toggles happen there)
+	const FLighterBlockSet* GetLitSet() const;						// Blocks lit by THIS ball as of the last update
 	
-	bool TraceGrounding();											// Trace for IsGrounded
-	WallingDirection TraceWalling();								// Direction in which the PlayerBall is close to a wall
+	bool TraceGrounding();											// Trace for IsGrounded (Fallback, see CONTACTS)
+	WallingDirection TraceWalling();								// Direction in which the PlayerBall is close to a wall (Fallback, see CONTACTS)
+
+	FVector GetRayFanDirection(const int32 TraceIndex) const;		// Direction of the Nth tracer line
+	void GetGroundingTraceEnds(FVector& OutLeft, FVector& OutRight) const;
+	void GetWallingTraceEnds(FVector& OutLeft, FVector& OutRight) const;
+
+
+
+
+	// SUBSTEP TRACER
+	// A fast ball covers more ground in one physics step than the Tracer sees from where it started
+	// => The cone is also traced at every substep along the predicted path & what it lights is committed before physics
+
+	int32 GetNumTracerSubsteps() const;								// 0 => Slow enough, one trace a frame is fine
+	void TraceSubsteps(FLighterBlockSet& hitSet, const int32 NumSubsteps);
+	float TracerDeltaSeconds = 0.f;									// This frame's, set before the Tracer runs
+
+
+
+
+	// ASYNC PROBES
+	// Front buffer	=> Emitter hits, bIsGrounded & bIsWalled (What the game uses this frame)
+	// Back buffer	=> AsyncHitSet, bAsyncGroundingHit & the wall hits (Filled by the trace delegates for next frame)
+
+	void SubmitAsyncProbes(const bool bProbeGrounding);				// Fire this frame's probes as one batch
+	void ConsumeAsyncProbes();										// Swap in last frame's results
+	void OnTracerProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void OnGroundingProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void OnWallingProbeDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	FTraceDelegate TracerProbeDelegate;
+	FTraceDelegate GroundingProbeDelegate;
+	FTraceDelegate WallingProbeDelegate;
+	FLighterBlockSet AsyncHitSet;
+	bool bAsyncGroundingHit = false;
+	bool bAsyncWallLeftHit = false;
+	bool bAsyncWallRightHit = false;
+	bool bAsyncGroundingProbed = false;								// The batch in flight has the Grounding & Walling rays (Contacts weren't trusted)
+	bool bHasAsyncResults = false;									// False until the first batch lands
+	uint32 AsyncProbeBatch = 0;										// Tags the batch so stale results are dropped
 
 
 
@@ -288,12 +508,19 @@ protected:
 		FDoubleJumpDelegate OnDoubleJump;
 
 	// Event to fire when PlayerBall exits a LighterBlock
+	// Fires once per frame, however many blocks were exited
 	UPROPERTY(BlueprintAssignable, Category = "Test")
 		FExitImpulseDelegate OnExitImpulse;
+
+	// Same, with the number of LighterBlocks exited that frame (Booster chains)
+	UPROPERTY(BlueprintAssignable, Category = "Test")
+		FExitImpulseBatchDelegate OnExitImpulseBatch;
 	
-	UPROPERTY(BlueprintReadOnly)
+	// Replicated to everyone but the owner (See NETWORK)
+	// Current only when the ball first becomes relevant, the SpotLight lerps towards Target from there
+	UPROPERTY(BlueprintReadOnly, ReplicatedUsing = OnRep_CurrentTracerRotation)
 		FRotator CurrentTracerRotation;
-	UPROPERTY(BlueprintReadOnly)
+	UPROPERTY(BlueprintReadOnly, Replicated)
 		FRotator TargetTracerRotation;
 #pragma endregion
 ////////////////////////////////////////////////////////////////////// TRACER
@@ -308,6 +535,38 @@ protected:
 #pragma region COLLISION
 public:
 	virtual void NotifyHit(class UPrimitiveComponent* MyComp, class AActor* Other, class UPrimitiveComponent* OtherComp, bool bSelfMoved, FVector HitLocation, FVector HitNormal, FVector NormalImpulse, const FHitResult& Hit) override;
+
+	// Which side the wall we're touching is on (bIsWalled => Not None)
+	FORCEINLINE WallingDirection GetWalledDirection() const { return WalledDirection; }
+
+private:
+	// CONTACTS
+	// bIsGrounded & bIsWalled come from what physics reports touching us (NotifyHit), not from probes
+	// Each contact lives for Lighter.ContactGrace after its last report, or until what it's on stops blocking us
+
+	struct FBallContact
+	{
+		TWeakObjectPtr<class UPrimitiveComponent> Component;
+		int32 BlockIndex = INDEX_NONE;							// LighterBlocks => The subsystem knows if it's still solid
+		FVector Normal = FVector::ZeroVector;					// Out of the surface, towards us
+		float Time = 0.f;										// World time of the last report
+	};
+
+	static constexpr int32 MaxContacts = 8;
+	TArray<FBallContact, TInlineAllocator<MaxContacts>> Contacts;
+	WallingDirection WalledDirection = WallingDirection::None;
+	float LastJumpTime = -1.f;									// Ground reported up to this frame is the ground we just left
+	bool bContactsReset = true;									// Spawned / restored => Nothing reported since, probe once
+
+	void RecordContact(class UPrimitiveComponent* Component, const int32 BlockIndex, const FVector& Normal);
+	bool IsContactBlocking(const FBallContact& Contact) const;
+	bool UpdateContactState();									// False => Contacts can't be trusted this frame, probe instead
+	void ResetContacts();
+
+public:
+	// Forwards per-instance EndOverlaps to ABlockFields
+	UFUNCTION()
+		void OnBallEndOverlap(class UPrimitiveComponent* OverlappedComp, class AActor* OtherActor, class UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 #pragma endregion
 
 
@@ -324,22 +583,81 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Input")
 		void EnablePlayerInput();
 protected:
-	float InputGamepadRX = 0.f;
-	float InputGamepadRY = 0.f;
-	
 	// Inputs to map
+	// They only fill in PendingInput, Tick applies it (So a replay can stand in for them)
 	void MoveRight(float Val);
 	void PointRight(float Val);
 	void PointUp(float Val);
 	void Jump();
 
+	void ApplyMoveRight(const float Val);
+	void ApplyJump();
+
 	
 	// Query mouse input per tick and differentiate between controller and mouse input
-	bool QueryMouseInput(class APlayerController* playerController);
-	bool QueryGamepadInput(class APlayerController* playerController);
+	bool QueryMouseInput(class APlayerController* playerController, FVector& OutPointerLocation);
+	bool QueryGamepadInput();
+	void PointTracerAt(const FVector& PointerLocation);
+
+	// Cursor => Gameplay plane at the PlayerBall's X (Pure math, no scene queries)
+	bool ProjectPointerToPlane(class APlayerController* playerController, const FVector2D& ViewportPosition, FVector& OutPointerLocation) const;
 
 private:
 	FVector LastPointerLocation;
+
+	// Latest mouse move since last frame (Only for the local player, null when there's no Slate)
+	TSharedPtr<FLighterPointerInput> PointerInput;
+	FVector2D LastPointerScreenPosition = FVector2D::ZeroVector;				// Desktop space, what the aim was last projected from
+
+	// When the cursor behind the current aim actually moved (FPlatformTime::Seconds())
+	double LastPointerSampleTime = 0.0;
+	double FirstPointerSampleTime = 0.0;										// First move of this frame's batch
+
+
+
+	// INPUT LATENCY (See LighterInputLatency.h)
+	// Samples that arrived this frame get a trace, cleared once ApplyInput is done with them
+	FLighterInputLatency* GetInputLatency() const;
+	uint32 BeginInputTrace(const ELighterInputSource Source, const double ArrivalTime) const;
+	double GetInputArrivalTime(const FName Binding, const bool bAxis) const;		// Latest preprocessor event among the binding's keys
+	void MarkInputApplied(uint32& Trace, const bool bSimulated);					// Applied now (& Simulated on the next physics step), then cleared
+	void MarkAimApplied(uint32& Trace);												// Same, & it becomes the aim the Tracer charges its blocks to
+
+	uint32 MoveRightTrace = 0;
+	uint32 JumpTrace = 0;
+	uint32 PointerTrace = 0;
+	uint32 GamepadTrace = 0;
+	uint32 AimTrace = 0;															// Newest aim the Tracer is heading for
+	uint32 AsyncAimTrace = 0;														// Aim the in-flight probe batch was fired with
+
+
+
+
+public:
+	// INPUT RECORDING & REPLAY (See LighterInputRecording.h)
+	void StartInputRecording();
+	bool StopInputRecording(const FString& Name);
+	bool StartInputReplay(const FString& Name, const bool bQuitWhenDone);
+
+	FORCEINLINE bool IsReplayingInput() const { return InputMode == ELighterInputMode::Replaying; }
+
+private:
+	void GatherInput(class APlayerController* playerController, const float DeltaSeconds);	// Live input or the next recorded frame
+	void ApplyInput();
+	void FinishInputFrame();														// Record / verify, then move on
+	void StopInputReplay();
+
+	ELighterInputMode InputMode = ELighterInputMode::Live;
+	FLighterInputFrame PendingInput;												// This frame's input
+	TSharedPtr<FLighterInputRecording> InputRecording;
+
+	FString ReplayName;
+	int32 ReplayFrame = 0;
+	int32 ReplayDivergedFrames = 0;
+	double ReplayStartTime = 0.0;
+	bool bQuitWhenReplayDone = false;
+	bool bWasUsingFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
 #pragma endregion
 ////////////////////////////////////////////////////////////////////// INPUT & CONTROL
 
@@ -356,6 +674,7 @@ private:
 ////////////////////////////////////////////////////////////////////// EVENTS
 #pragma region BEGINPLAY & TICK
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 #pragma endregion
 };
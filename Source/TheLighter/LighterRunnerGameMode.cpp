@@ -0,0 +1,362 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Endless LighterBlock runner => Blocks laid out ahead of the ball & recycled behind it
+
+#include "LighterRunnerGameMode.h"
+#include "TheLighter.h"
+#include "Gameplay/Block.h"
+#include "Gameplay/TheLighterBall.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+
+////////////////////////////////////////////////////////////////////// CORE
+#pragma region CORE
+ALighterRunnerGameMode::ALighterRunnerGameMode()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMesh(TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+	BlockMesh = CubeMesh.Object;
+}
+
+void ALighterRunnerGameMode::BeginPlay()
+{
+	LIGHTER_LLM_SCOPE();
+	Super::BeginPlay();
+
+	// -LighterRunnerSeed=N replays a run from the command line
+	FParse::Value(FCommandLine::Get(), TEXT("LighterRunnerSeed="), Seed);
+	Random.Initialize(Seed);
+
+	if (!BlockMesh)
+	{
+		UE_LOG(LogTheLighter, Error, TEXT("LighterRunnerGameMode has no BlockMesh, nothing will be generated"));
+		return;
+	}
+
+	// The only blocks this run is ever going to spawn
+	FreeBlocks.Reserve(PoolSize);
+	LiveBlocks.Init(nullptr, PoolSize);
+	Pending.Blocks.Reserve(64);
+
+	UWorld* world = GetWorld();
+	for (int32 i = 0; i < PoolSize; ++i)
+	{
+		ABlock* block = world->SpawnActorDeferred<ABlock>(ABlock::StaticClass(), FTransform(ParkingLocation), this, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		block->MeshComp->SetStaticMesh(BlockMesh);
+		block->FinishSpawning(FTransform(ParkingLocation));
+		block->SetActorHiddenInGame(true);
+		FreeBlocks.Add(block);
+	}
+
+	UE_LOG(LogTheLighter, Log, TEXT("LighterRunnerGameMode => Seed %d, %d pooled blocks"), Seed, PoolSize);
+}
+
+void ALighterRunnerGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// A soak that got cut short still reports what it got
+	if (bSoaking)
+		FinishSoak();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ALighterRunnerGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	if (LiveBlocks.Num() == 0) return;
+
+	if (bSoaking)
+		TickSoak(DeltaSeconds);
+
+	float minY, maxY;
+	if (!GetBallRange(minY, maxY)) return;
+
+	// The run starts wherever the first ball is
+	if (!bStarted)
+	{
+		const FVector start = GetWorld()->GetSubsystem<ULighterBlockSubsystem>()->GetBalls()[0]->GetActorLocation();
+		RunX = start.X;
+		BaseZ = start.Z;
+		NextPatternY = maxY + PatternGap;
+		NextPatternZ = BaseZ;
+		bStarted = true;
+	}
+
+	RecycleUpTo(minY - RecycleBehind);
+	GenerateUpTo(maxY + GenerateAhead);
+
+	if (maxY > RebaseDistance)
+		Rebase(-RebaseDistance);
+}
+#pragma endregion CORE
+////////////////////////////////////////////////////////////////////// CORE
+
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// GENERATION
+#pragma region GENERATION
+bool ALighterRunnerGameMode::GetBallRange(float& OutMinY, float& OutMaxY) const
+{
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	if (!subsystem || subsystem->GetBalls().Num() == 0) return false;
+
+	OutMinY = MAX_flt;
+	OutMaxY = -MAX_flt;
+	for (const ATheLighterBall* ball : subsystem->GetBalls())
+	{
+		if (!ball) continue;
+		const float y = ball->GetActorLocation().Y;
+		OutMinY = FMath::Min(OutMinY, y);
+		OutMaxY = FMath::Max(OutMaxY, y);
+	}
+	return OutMinY <= OutMaxY;
+}
+
+void ALighterRunnerGameMode::GenerateUpTo(const float Y)
+{
+	while (NextPatternY < Y)
+	{
+		// Rolled once, then it waits for enough free blocks (Keeps the run the same for the same seed)
+		if (!bHasPending)
+		{
+			Pending.Reset();
+			const ELighterRunnerPattern pattern = LighterRunnerPatterns::Generate(Random, FVector2D(NextPatternY, NextPatternZ), BlockSpacing, BaseZ + MinZ, BaseZ + MaxZ, Pending);
+			++PatternCounts[(int32)pattern];
+			++NumPatterns;
+
+			// Can't ever wait on more than the whole pool
+			if (Pending.Blocks.Num() > LiveBlocks.Num())
+				Pending.Blocks.SetNum(LiveBlocks.Num(), false);
+			bHasPending = true;
+		}
+
+		if (Pending.Blocks.Num() > FreeBlocks.Num()) return;
+
+		for (const FVector2D& location : Pending.Blocks)
+		{
+			ABlock* block = FreeBlocks.Pop(false);
+			block->Relocate(FVector(RunX, location.X, location.Y));
+			block->SetActorHiddenInGame(false);
+
+			LiveBlocks[(LiveStart + NumLive) % LiveBlocks.Num()] = block;
+			++NumLive;
+		}
+
+		NextPatternY = Pending.EndY + PatternGap;
+		NextPatternZ = Pending.EndZ;
+		bHasPending = false;
+	}
+}
+
+void ALighterRunnerGameMode::RecycleUpTo(const float Y)
+{
+	// Oldest first, so the first block that's still in range ends it
+	while (NumLive > 0)
+	{
+		ABlock* block = LiveBlocks[LiveStart];
+		if (block && block->GetActorLocation().Y >= Y) return;
+
+		LiveBlocks[LiveStart] = nullptr;
+		LiveStart = (LiveStart + 1) % LiveBlocks.Num();
+		--NumLive;
+
+		if (block)
+			ReleaseBlock(block);
+	}
+}
+
+void ALighterRunnerGameMode::ReleaseBlock(ABlock* Block)
+{
+	Block->Relocate(ParkingLocation);
+	Block->SetActorHiddenInGame(true);
+	FreeBlocks.Push(Block);
+}
+
+// Balls teleport (Velocity kept), live blocks get Shifted => Same run, Offset further back along Y
+// Shifting keeps the blocks registered, so whatever's lit & solid (The block under the ball) stays that way
+// A checkpoint taken before the shift would put the balls back in the old frame, so it's dropped
+
+void ALighterRunnerGameMode::Rebase(const float Offset)
+{
+	LIGHTER_LLM_SCOPE();
+	const FVector shift(0.f, Offset, 0.f);
+	ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	subsystem->ClearCheckpoint();
+
+	for (ATheLighterBall* ball : subsystem->GetBalls())
+		if (ball)
+			ball->SetActorLocation(ball->GetActorLocation() + shift, false, nullptr, ETeleportType::TeleportPhysics);
+
+	for (int32 i = 0; i < NumLive; ++i)
+		if (ABlock* block = LiveBlocks[(LiveStart + i) % LiveBlocks.Num()])
+			block->Shift(shift);
+
+	for (FVector2D& location : Pending.Blocks)
+		location.X += Offset;
+	Pending.EndY += Offset;
+	NextPatternY += Offset;
+	++NumRebases;
+
+	UE_LOG(LogTheLighter, Verbose, TEXT("LighterRunnerGameMode => Rebased by %.0f (%d live blocks)"), Offset, NumLive);
+}
+#pragma endregion GENERATION
+////////////////////////////////////////////////////////////////////// GENERATION
+
+
+
+
+
+
+
+
+////////////////////////////////////////////////////////////////////// SOAK
+#pragma region SOAK
+void ALighterRunnerGameMode::StartSoak(const float Minutes, const float Speed, const bool bQuitWhenDone)
+{
+	LIGHTER_LLM_SCOPE();
+
+	// Both histograms are sized here, nothing grows while it runs
+	const int32 numBuckets = SoakBucketsPerMs * SoakHistogramMs + 1;
+	SoakHistogram.Init(0, numBuckets);
+	SoakMinuteHistogram.Init(0, numBuckets);
+	SoakFrames = 0;
+	SoakMinuteFrames = 0;
+	SoakMaxFrameMs = 0.f;
+
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	SoakZ = subsystem && subsystem->GetBalls().Num() > 0 && subsystem->GetBalls()[0] ? subsystem->GetBalls()[0]->GetActorLocation().Z : BaseZ;
+	SoakSpeed = Speed;
+	bQuitWhenSoakDone = bQuitWhenDone;
+
+	SoakStartTime = FPlatformTime::Seconds();
+	SoakEndTime = SoakStartTime + Minutes * 60.0;
+	SoakNextReport = SoakStartTime + 60.0;
+	SoakLastFrame = SoakStartTime;
+
+	SoakStartUsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+	SoakPeakUsedMemory = SoakStartUsedMemory;
+	bSoaking = true;
+
+	UE_LOG(LogTheLighter, Log, TEXT("Lighter.Runner.Soak => %.1f minutes at %.0f units/s, %.1f MB in use"), Minutes, Speed, SoakStartUsedMemory / (1024.0 * 1024.0));
+}
+
+void ALighterRunnerGameMode::TickSoak(const float DeltaSeconds)
+{
+	// Wall clock, so a clamped or dilated game delta can't hide a hitch
+	const double now = FPlatformTime::Seconds();
+	const float frameMs = (float)((now - SoakLastFrame) * 1000.0);
+	SoakLastFrame = now;
+
+	const int32 bucket = FMath::Min(FMath::FloorToInt(frameMs * SoakBucketsPerMs), SoakHistogram.Num() - 1);
+	++SoakHistogram[bucket];
+	++SoakMinuteHistogram[bucket];
+	++SoakFrames;
+	++SoakMinuteFrames;
+	SoakMaxFrameMs = FMath::Max(SoakMaxFrameMs, frameMs);
+
+	// Autopilot => Every ball straight along +Y at a fixed height
+	// Teleported, so a solid block can't stop the run, but the overlaps, Tracer & streaming all still happen
+	for (ATheLighterBall* ball : GetWorld()->GetSubsystem<ULighterBlockSubsystem>()->GetBalls())
+	{
+		if (!ball) continue;
+		const FVector location = ball->GetActorLocation();
+		ball->SetActorLocation(FVector(location.X, location.Y + SoakSpeed * DeltaSeconds, SoakZ), false, nullptr, ETeleportType::TeleportPhysics);
+		if (UPrimitiveComponent* body = Cast<UPrimitiveComponent>(ball->GetRootComponent()))
+			body->SetPhysicsLinearVelocity(FVector(0.f, SoakSpeed, 0.f));
+	}
+
+	if (now >= SoakNextReport)
+	{
+		ReportSoakMinute();
+		SoakNextReport += 60.0;
+	}
+
+	if (now >= SoakEndTime)
+		FinishSoak();
+}
+
+void ALighterRunnerGameMode::ReportSoakMinute()
+{
+	// Memory only gets sampled here, reading it isn't free on every platform
+	const uint64 usedMemory = FPlatformMemory::GetStats().UsedPhysical;
+	SoakPeakUsedMemory = FMath::Max(SoakPeakUsedMemory, usedMemory);
+
+	const ULighterBlockSubsystem* subsystem = GetWorld()->GetSubsystem<ULighterBlockSubsystem>();
+	UE_LOG(LogTheLighter, Log, TEXT("Lighter.Runner.Soak %.0f min | p50 %.1f ms | p99 %.1f ms | %.1f MB (%+.1f) | Live %d | Free %d | Registered %d | Patterns %d | Rebases %d"),
+		(FPlatformTime::Seconds() - SoakStartTime) / 60.0,
+		GetFrameTimePercentile(SoakMinuteHistogram, SoakMinuteFrames, 50.f),
+		GetFrameTimePercentile(SoakMinuteHistogram, SoakMinuteFrames, 99.f),
+		usedMemory / (1024.0 * 1024.0), ((double)usedMemory - (double)SoakStartUsedMemory) / (1024.0 * 1024.0),
+		NumLive, FreeBlocks.Num(), subsystem ? subsystem->GetNumBlocks() : 0, NumPatterns, NumRebases);
+
+	FMemory::Memzero(SoakMinuteHistogram.GetData(), SoakMinuteHistogram.Num() * sizeof(uint32));
+	SoakMinuteFrames = 0;
+}
+
+void ALighterRunnerGameMode::FinishSoak()
+{
+	bSoaking = false;
+
+	const uint64 endUsedMemory = FPlatformMemory::GetStats().UsedPhysical;
+	SoakPeakUsedMemory = FMath::Max(SoakPeakUsedMemory, endUsedMemory);
+	const double minutes = (FPlatformTime::Seconds() - SoakStartTime) / 60.0;
+	const double growthMB = ((double)endUsedMemory - (double)SoakStartUsedMemory) / (1024.0 * 1024.0);
+
+	const float percentiles[] = { 50.f, 90.f, 99.f, 99.9f };
+	FString csv = TEXT("Minutes,Frames,P50Ms,P90Ms,P99Ms,P999Ms,MaxMs,StartMB,EndMB,PeakMB,Patterns,Rebases\n");
+	FString line = FString::Printf(TEXT("%.1f,%llu"), minutes, SoakFrames);
+	for (const float percentile : percentiles)
+		line += FString::Printf(TEXT(",%.2f"), GetFrameTimePercentile(SoakHistogram, SoakFrames, percentile));
+	line += FString::Printf(TEXT(",%.2f,%.1f,%.1f,%.1f,%d,%d"), SoakMaxFrameMs,
+		SoakStartUsedMemory / (1024.0 * 1024.0), endUsedMemory / (1024.0 * 1024.0), SoakPeakUsedMemory / (1024.0 * 1024.0), NumPatterns, NumRebases);
+	csv += line + TEXT("\n");
+
+	UE_LOG(LogTheLighter, Log, TEXT("Lighter.Runner.Soak done => %s"), *line);
+	UE_LOG(LogTheLighter, Log, TEXT("Lighter.Runner.Soak patterns => Stairs %d | BoosterChain %d | Grid %d"),
+		PatternCounts[(int32)ELighterRunnerPattern::Stairs], PatternCounts[(int32)ELighterRunnerPattern::BoosterChain], PatternCounts[(int32)ELighterRunnerPattern::Grid]);
+	if (growthMB > 64.0)
+		UE_LOG(LogTheLighter, Warning, TEXT("Lighter.Runner.Soak => Memory grew %.1f MB over the run"), growthMB);
+
+	const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Soak-%s.csv"), *FDateTime::Now().ToString());
+	if (FFileHelper::SaveStringToFile(csv, *csvPath))
+		UE_LOG(LogTheLighter, Log, TEXT("Lighter.Runner.Soak results written to %s"), *csvPath);
+
+	if (bQuitWhenSoakDone && GEngine)
+		GEngine->DeferredCommands.Add(TEXT("quit"));
+}
+
+float ALighterRunnerGameMode::GetFrameTimePercentile(const TArray<uint32>& Histogram, const uint64 Frames, const float Percentile)
+{
+	if (Frames == 0) return 0.f;
+
+	// Upper edge of the bucket the Nth frame falls in
+	const uint64 target = FMath::Max<uint64>(1, (uint64)FMath::CeilToDouble(Frames * (double)Percentile / 100.0));
+	uint64 count = 0;
+	for (int32 bucket = 0; bucket < Histogram.Num(); ++bucket)
+	{
+		count += Histogram[bucket];
+		if (count >= target)
+			return (bucket + 1) / (float)SoakBucketsPerMs;
+	}
+	return SoakHistogramMs;
+}
+#pragma endregion SOAK
+////////////////////////////////////////////////////////////////////// SOAK
@@ -0,0 +1,176 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Endless LighterBlock runner => Blocks laid out ahead of the ball & recycled behind it
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TheLighterGameMode.h"
+#include "Math/RandomStream.h"
+#include "Gameplay/LighterRunnerPatterns.h"
+#include "LighterRunnerGameMode.generated.h"
+
+
+/*
+* Nothing gets spawned or destroyed once the run's going
+*
+* 1. BeginPlay		=> PoolSize ABlocks get spawned ONCE & parked out of the way
+* 2. Ahead			=> Seeded patterns (See LighterRunnerPatterns.h) are laid out GenerateAhead in front of the lead ball
+* 					   Each block comes off the pool & is Relocated into place
+* 3. Behind			=> Blocks RecycleBehind the last ball go back to the pool
+* 4. Rebase			=> Past RebaseDistance the whole run (Balls & live blocks) shifts back along Y
+* 					   Keeps everything near the origin, however long the run is
+*
+* Live blocks are a ring in generation order, so the oldest (Furthest behind) is always at the front
+* A pattern that doesn't fit in the free pool yet waits for the recycling, it never gets re-rolled
+*
+* NOTE: Every container is sized at BeginPlay, so frame time & memory stay flat over the run
+* 		Lighter.Runner.Soak checks exactly that (See LighterRunnerDebug.cpp)
+*/
+
+UCLASS()
+class ALighterRunnerGameMode : public ATheLighterGameMode
+{
+	GENERATED_BODY()
+
+#pragma region CORE
+public:
+	ALighterRunnerGameMode();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+#pragma endregion
+
+
+
+
+#pragma region CONFIG
+public:
+	// Same seed => Same run
+	UPROPERTY(EditAnywhere, Category = "Runner")
+		int32 Seed = 1;
+
+	// Every block the run will ever use
+	UPROPERTY(EditAnywhere, Category = "Runner", meta = (ClampMin = "1"))
+		int32 PoolSize = 600;
+
+	UPROPERTY(EditAnywhere, Category = "Runner")
+		class UStaticMesh* BlockMesh;
+
+	// Size of one block (The patterns are laid out in these)
+	UPROPERTY(EditAnywhere, Category = "Runner", meta = (ClampMin = "1.0"))
+		float BlockSpacing = 100.f;
+
+	// Empty space between two patterns
+	UPROPERTY(EditAnywhere, Category = "Runner", meta = (ClampMin = "0.0"))
+		float PatternGap = 400.f;
+
+	UPROPERTY(EditAnywhere, Category = "Runner", meta = (ClampMin = "0.0"))
+		float GenerateAhead = 8000.f;
+
+	UPROPERTY(EditAnywhere, Category = "Runner", meta = (ClampMin = "0.0"))
+		float RecycleBehind = 3000.f;
+
+	// Z band the patterns stay in, relative to where the ball started
+	UPROPERTY(EditAnywhere, Category = "Runner")
+		float MinZ = -300.f;
+
+	UPROPERTY(EditAnywhere, Category = "Runner")
+		float MaxZ = 900.f;
+
+	// Distance along Y the run goes before it shifts back
+	UPROPERTY(EditAnywhere, Category = "Runner", meta = (ClampMin = "1000.0"))
+		float RebaseDistance = 50000.f;
+#pragma endregion
+
+
+
+
+#pragma region POOL
+public:
+	FORCEINLINE int32 GetNumFreeBlocks() const { return FreeBlocks.Num(); }
+	FORCEINLINE int32 GetNumLiveBlocks() const { return NumLive; }
+	FORCEINLINE int32 GetNumPatterns() const { return NumPatterns; }
+	FORCEINLINE int32 GetNumPatterns(const ELighterRunnerPattern Pattern) const { return PatternCounts[(int32)Pattern]; }
+	FORCEINLINE int32 GetNumRebases() const { return NumRebases; }
+
+private:
+	void ReleaseBlock(class ABlock* Block);
+
+	UPROPERTY(Transient)
+		TArray<class ABlock*> FreeBlocks;
+
+	// Ring of live blocks, oldest first
+	UPROPERTY(Transient)
+		TArray<class ABlock*> LiveBlocks;
+	int32 LiveStart = 0;
+	int32 NumLive = 0;
+
+	// Free blocks wait here (Far from any ball, so streaming keeps them asleep)
+	FVector ParkingLocation = FVector(0.f, 0.f, -100000.f);
+#pragma endregion
+
+
+
+
+#pragma region GENERATION
+private:
+	// Lead & tail ball along Y (False if there's no ball yet)
+	bool GetBallRange(float& OutMinY, float& OutMaxY) const;
+
+	void GenerateUpTo(const float Y);
+	void RecycleUpTo(const float Y);
+	void Rebase(const float Offset);
+
+	FRandomStream Random;
+	LighterRunnerPatterns::FLayout Pending;
+	bool bHasPending = false;
+	bool bStarted = false;
+
+	float NextPatternY = 0.f;
+	float NextPatternZ = 0.f;
+	float BaseZ = 0.f;
+	float RunX = 0.f;
+
+	int32 NumPatterns = 0;
+	int32 PatternCounts[(int32)ELighterRunnerPattern::Num] = {};
+	int32 NumRebases = 0;
+#pragma endregion
+
+
+
+
+#pragma region SOAK
+public:
+	// Drive the lead ball forward on its own for Minutes & report the frame times (Percentiles) & memory
+	void StartSoak(const float Minutes, const float Speed, const bool bQuitWhenDone);
+	FORCEINLINE bool IsSoaking() const { return bSoaking; }
+
+private:
+	void TickSoak(const float DeltaSeconds);
+	void ReportSoakMinute();
+	void FinishSoak();
+	static float GetFrameTimePercentile(const TArray<uint32>& Histogram, const uint64 Frames, const float Percentile);
+
+	bool bSoaking = false;
+	bool bQuitWhenSoakDone = false;
+	float SoakSpeed = 1500.f;
+	float SoakZ = 0.f;
+	double SoakStartTime = 0.0;
+	double SoakEndTime = 0.0;
+	double SoakNextReport = 0.0;
+	double SoakLastFrame = 0.0;
+
+	// 0.1 ms buckets up to SoakHistogramMs, everything above lands in the last one
+	static constexpr int32 SoakBucketsPerMs = 10;
+	static constexpr int32 SoakHistogramMs = 250;
+	TArray<uint32> SoakHistogram;
+	TArray<uint32> SoakMinuteHistogram;
+	uint64 SoakFrames = 0;
+	uint64 SoakMinuteFrames = 0;
+	float SoakMaxFrameMs = 0.f;
+
+	uint64 SoakStartUsedMemory = 0;
+	uint64 SoakPeakUsedMemory = 0;
+#pragma endregion
+};
@@ -0,0 +1,161 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Automation tests for the HITSET / LITSET container
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "Gameplay/LighterBlockSet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Session Frontend => Automation => TheLighter.BlockSet
+* Headless:
+* 		UE4Editor-Cmd TheLighter.uproject -nullrhi -unattended -ExecCmds="Automation RunTests TheLighter.BlockSet; Quit"
+*/
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterBlockSetAddRemoveTest, "TheLighter.BlockSet.AddRemoveContains",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterBlockSetAddRemoveTest::RunTest(const FString& Parameters)
+{
+	FLighterBlockSet set;
+	TestFalse(TEXT("Empty set contains nothing"), set.Contains(0));
+	TestFalse(TEXT("Out of range index isn't contained"), set.Contains(1000));
+	TestFalse(TEXT("Negative index isn't contained"), set.Contains(INDEX_NONE));
+
+	TestTrue(TEXT("Add a new member"), set.Add(3));
+	TestFalse(TEXT("Adding it twice is a no-op"), set.Add(3));
+	TestTrue(TEXT("Add past the current bits"), set.Add(200));
+	TestEqual(TEXT("Two members"), set.Num(), 2);
+	TestTrue(TEXT("Contains 3"), set.Contains(3));
+	TestTrue(TEXT("Contains 200"), set.Contains(200));
+	TestFalse(TEXT("Doesn't contain 4"), set.Contains(4));
+
+	TestTrue(TEXT("Remove a member"), set.Remove(3));
+	TestFalse(TEXT("Removing it twice is a no-op"), set.Remove(3));
+	TestFalse(TEXT("Removing a non-member is a no-op"), set.Remove(7));
+	TestFalse(TEXT("Removed member is gone"), set.Contains(3));
+	TestEqual(TEXT("One member left"), set.Num(), 1);
+
+	// Last member out => Empty, but the bits stay sized
+	TestTrue(TEXT("Remove the last member"), set.Remove(200));
+	TestEqual(TEXT("Empty after the last member"), set.Num(), 0);
+	TestFalse(TEXT("Last member is gone"), set.Contains(200));
+
+	// Re-adding after a remove => Exactly once in the members
+	TestTrue(TEXT("Re-add after remove"), set.Add(200));
+	TestTrue(TEXT("Re-added member is in"), set.Contains(200));
+	TestEqual(TEXT("Re-added member listed once"), set.GetMembers().Num(), 1);
+
+	// Swap-remove from the middle => The member moved into the gap can still be removed
+	for (const int32 blockIndex : { 10, 20, 30, 40 })
+		set.Add(blockIndex);
+	TestTrue(TEXT("Remove from the middle"), set.Remove(20));
+	TestTrue(TEXT("Remove the swapped-in member"), set.Remove(40));
+	TestTrue(TEXT("Remove the first member"), set.Remove(10));
+	TestTrue(TEXT("Members left"), set.GetMembers() == TArray<int32>({ 200, 30 }));
+
+	set.Add(5);
+	set.Reset();
+	TestEqual(TEXT("Reset empties"), set.Num(), 0);
+	TestFalse(TEXT("Reset clears the bits"), set.Contains(5) || set.Contains(200));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterBlockSetDiffTest, "TheLighter.BlockSet.Diff",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterBlockSetDiffTest::RunTest(const FString& Parameters)
+{
+	FLighterBlockSet lit, hit;
+	for (const int32 blockIndex : { 1, 2, 3, 10 })
+		lit.Add(blockIndex);
+	for (const int32 blockIndex : { 2, 3, 4, 50 })
+		hit.Add(blockIndex);
+
+	TArray<int32> added, removed;
+	lit.Diff(hit, added, removed);
+	added.Sort();
+	removed.Sort();
+	TestTrue(TEXT("Added"), added == TArray<int32>({ 4, 50 }));
+	TestTrue(TEXT("Removed"), removed == TArray<int32>({ 1, 10 }));
+
+	// Same members => Nothing either way
+	added.Reset();
+	removed.Reset();
+	lit.Diff(lit, added, removed);
+	TestTrue(TEXT("Self diff is empty"), added.Num() == 0 && removed.Num() == 0);
+
+	// Against an empty set => Everything removed
+	added.Reset();
+	removed.Reset();
+	lit.Diff(FLighterBlockSet(), added, removed);
+	TestTrue(TEXT("Diff against empty removes all"), added.Num() == 0 && removed.Num() == lit.Num());
+
+	// Removed last member, then re-added => Shows up again
+	hit.Remove(50);
+	hit.Add(50);
+	added.Reset();
+	removed.Reset();
+	lit.Diff(hit, added, removed);
+	TestTrue(TEXT("Re-added member diffs as added"), added.Contains(50));
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterBlockSetDiffScalingTest, "TheLighter.BlockSet.DiffScaling",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterBlockSetDiffScalingTest::RunTest(const FString& Parameters)
+{
+	// Same 64 members in both sets, only the universe (The highest BlockIndex ever seen) grows
+	// => Diff only walks the members, its cost can't follow the universe
+	const int32 numMembers = 64;
+	const int32 rounds = 2000;
+	const int32 universes[] = { 1000, 1000000 };
+	double seconds[UE_ARRAY_COUNT(universes)];
+
+	TArray<int32> added, removed;
+	added.Reserve(numMembers);
+	removed.Reserve(numMembers);
+
+	for (int32 u = 0; u < UE_ARRAY_COUNT(universes); ++u)
+	{
+		FLighterBlockSet lit, hit;
+		lit.Add(universes[u] - 1);
+		lit.Remove(universes[u] - 1);
+		hit.Add(universes[u] - 1);
+		hit.Remove(universes[u] - 1);
+		for (int32 i = 0; i < numMembers; ++i)
+		{
+			lit.Add(i * 2);
+			hit.Add(i * 2 + (i % 2));
+		}
+
+		// Best of a few runs => Scheduler noise doesn't fail the test
+		seconds[u] = MAX_dbl;
+		for (int32 run = 0; run < 5; ++run)
+		{
+			const double start = FPlatformTime::Seconds();
+			for (int32 round = 0; round < rounds; ++round)
+			{
+				added.Reset();
+				removed.Reset();
+				lit.Diff(hit, added, removed);
+			}
+			seconds[u] = FMath::Min(seconds[u], FPlatformTime::Seconds() - start);
+		}
+		TestEqual(TEXT("Half the members differ each way"), added.Num(), numMembers / 2);
+	}
+
+	AddInfo(FString::Printf(TEXT("Diff of %d members => %.2f us at %d blocks, %.2f us at %d blocks"), numMembers,
+		seconds[0] * 1000000.0 / rounds, universes[0], seconds[1] * 1000000.0 / rounds, universes[1]));
+
+	// 1000x the universe => Well under 1000x the cost (A few x of headroom for the timer)
+	TestTrue(TEXT("Diff cost stays flat as the universe grows"), seconds[1] < seconds[0] * 4.0 + 0.0005);
+	return true;
+}
+
+#endif
@@ -0,0 +1,69 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Automation tests for the pooled effect bookkeeping
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Gameplay/LighterEffectPool.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Session Frontend => Automation => TheLighter.Effects
+* Headless (Bookkeeping only, no components or rendering involved):
+* 		UE4Editor-Cmd TheLighter.uproject -nullrhi -unattended -ExecCmds="Automation RunTests TheLighter.Effects; Quit"
+*/
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterEffectPoolTest, "TheLighter.Effects.Pool",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterEffectPoolTest::RunTest(const FString& Parameters)
+{
+	FLighterEffectPool::EAcquire result;
+
+	// Cap of 3, 2 pre-warmed
+	FLighterEffectPool pool(3);
+	TestEqual(TEXT("First prewarmed slot"), pool.AddFreeSlot(), 0);
+	TestEqual(TEXT("Second prewarmed slot"), pool.AddFreeSlot(), 1);
+	TestEqual(TEXT("Prewarmed slots are free"), pool.GetNumFree(), 2);
+
+	// 1. Pre-warmed slots => Hits
+	const int32 first = pool.Acquire(result);
+	TestTrue(TEXT("First acquire is a hit"), result == FLighterEffectPool::EAcquire::Hit);
+	const int32 second = pool.Acquire(result);
+	TestTrue(TEXT("Second acquire is a hit"), result == FLighterEffectPool::EAcquire::Hit);
+	TestNotEqual(TEXT("Hits hand out different slots"), second, first);
+
+	// 2. Out of free slots, under the cap => Miss (New slot)
+	const int32 third = pool.Acquire(result);
+	TestTrue(TEXT("Third acquire grows the pool"), result == FLighterEffectPool::EAcquire::Miss);
+	TestEqual(TEXT("Grown slot comes after the prewarmed ones"), third, 2);
+	TestEqual(TEXT("Prewarm stops at the cap"), pool.AddFreeSlot(), (int32)INDEX_NONE);
+
+	// 3. At the cap => The oldest active slot gets restarted
+	const int32 evicted = pool.Acquire(result);
+	TestTrue(TEXT("Fourth acquire evicts"), result == FLighterEffectPool::EAcquire::Evicted);
+	TestEqual(TEXT("Eviction takes the oldest"), evicted, first);
+	TestEqual(TEXT("Never more slots than the cap"), pool.GetNumSlots(), 3);
+	TestEqual(TEXT("Never more active than the cap"), pool.GetNumActive(), 3);
+
+	// 4. Release => Reused next, without growing
+	TestTrue(TEXT("Release of an active slot"), pool.Release(second));
+	TestFalse(TEXT("Double release is refused"), pool.Release(second));
+	const int32 reused = pool.Acquire(result);
+	TestTrue(TEXT("Released slot is a hit"), result == FLighterEffectPool::EAcquire::Hit);
+	TestEqual(TEXT("Released slot gets reused"), reused, second);
+	TestEqual(TEXT("Reuse doesn't grow"), pool.GetNumSlots(), 3);
+
+	// 5. The evicted slot is now the newest instance => Next eviction takes the one after it
+	const int32 evictedAgain = pool.Acquire(result);
+	TestTrue(TEXT("Fifth acquire evicts"), result == FLighterEffectPool::EAcquire::Evicted);
+	TestEqual(TEXT("Eviction follows acquire order"), evictedAgain, third);
+
+	const FLighterEffectPool::FStats& stats = pool.GetStats();
+	TestEqual(TEXT("Hits"), (int32)stats.Hits, 3);
+	TestEqual(TEXT("Misses"), (int32)stats.Misses, 1);
+	TestEqual(TEXT("Evictions"), (int32)stats.Evictions, 2);
+	return true;
+}
+
+#endif
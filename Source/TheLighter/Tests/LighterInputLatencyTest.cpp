@@ -0,0 +1,164 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Automation tests for the input => effect latency traces
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "Gameplay/Block.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+#include "Gameplay/LighterInputLatency.h"
+#include "Tests/LighterTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Session Frontend => Automation => TheLighter.Latency
+* Headless:
+* 		UE4Editor-Cmd TheLighter.uproject -nullrhi -unattended -ExecCmds="Automation RunTests TheLighter.Latency; Quit"
+*
+* Both turn Lighter.InputLatency on for their length & put it back after
+*/
+
+// Lighter.InputLatency 1 until the end of the enclosing scope
+#define LIGHTER_ENABLE_INPUT_LATENCY() \
+	IConsoleVariable* inputLatencyVar = IConsoleManager::Get().FindConsoleVariable(TEXT("Lighter.InputLatency")); \
+	const int32 previousInputLatency = inputLatencyVar ? inputLatencyVar->GetInt() : 0; \
+	if (inputLatencyVar) inputLatencyVar->Set(1, ECVF_SetByCode); \
+	ON_SCOPE_EXIT { if (inputLatencyVar) inputLatencyVar->Set(previousInputLatency, ECVF_SetByCode); }
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterLatencyTracesTest, "TheLighter.Latency.Traces",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterLatencyTracesTest::RunTest(const FString& Parameters)
+{
+	LIGHTER_ENABLE_INPUT_LATENCY();
+	if (!TestTrue(TEXT("Lighter.InputLatency is on"), FLighterInputLatency::IsEnabled()))
+		return false;
+
+	// A standalone tracker fed made up timestamps
+	FLighterInputLatency latency;
+	const double t = 1000.0;
+
+	// 1. Pointer, 4.2 ms to the tracer, 20 ms to the collision => Once each, however often it's reached
+	const uint32 pointer = latency.Begin(ELighterInputSource::Pointer, t);
+	TestTrue(TEXT("Begin hands out a trace"), pointer != 0 && latency.IsAlive(pointer, t));
+	latency.Reach(pointer, ELighterLatencyStage::Traced, t + 0.0042);
+	latency.Reach(pointer, ELighterLatencyStage::Traced, t + 0.010);
+	latency.Reach(pointer, ELighterLatencyStage::Simulated, t + 0.020);
+
+	const FLighterLatencyHistogram& traced = latency.GetHistogram(ELighterInputSource::Pointer, ELighterLatencyStage::Traced);
+	TestTrue(TEXT("A stage counts once per trace"), traced.Count == 1);
+	TestEqual(TEXT("Tracer stamp"), traced.MaxMs, 4.2, 0.01);
+	TestEqual(TEXT("4.2 ms lands in the 4 ms bucket"), (int32)traced.Buckets[4 * FLighterInputLatency::BucketsPerMs], 1);
+	TestEqual(TEXT("P50 of one 4.2 ms sample is its bucket's upper edge"), traced.GetPercentileMs(50.f), 4.f + 1.f / FLighterInputLatency::BucketsPerMs);
+
+	const FLighterLatencyHistogram& collision = latency.GetHistogram(ELighterInputSource::Pointer, ELighterLatencyStage::Simulated);
+	TestTrue(TEXT("Collision recorded"), collision.Count == 1);
+	TestEqual(TEXT("Collision stamp"), collision.MaxMs, 20.0, 0.01);
+
+	// 2. Jump => Simulated waits for the physics step
+	const uint32 jump = latency.Begin(ELighterInputSource::Jump, t);
+	latency.Reach(jump, ELighterLatencyStage::Applied, t + 0.001);
+	latency.ReachOnPhysicsStep(jump);
+	const FLighterLatencyHistogram& simulated = latency.GetHistogram(ELighterInputSource::Jump, ELighterLatencyStage::Simulated);
+	TestTrue(TEXT("Nothing simulated before the step"), simulated.Count == 0);
+	latency.OnPhysicsStep(t + 0.008);
+	latency.OnPhysicsStep(t + 0.024);
+	TestTrue(TEXT("Simulated at the first step only"), simulated.Count == 1);
+	TestEqual(TEXT("Simulated stamp"), simulated.MaxMs, 8.0, 0.01);
+
+	// 3. Stale & unknown traces go nowhere
+	const uint32 stale = latency.Begin(ELighterInputSource::Gamepad, t);
+	const double late = t + (FLighterInputLatency::MaxTraceMs + 1) / 1000.0;
+	TestFalse(TEXT("Stale trace isn't alive"), latency.IsAlive(stale, late));
+	latency.Reach(stale, ELighterLatencyStage::Contact, late);
+	latency.Reach(0, ELighterLatencyStage::Contact, t);
+	latency.Reach(stale + 12345, ELighterLatencyStage::Contact, t);
+	TestTrue(TEXT("Stale & unknown traces are dropped"), latency.GetHistogram(ELighterInputSource::Gamepad, ELighterLatencyStage::Contact).Count == 0);
+
+	// 4. A full ring overwrites the oldest trace
+	for (int32 i = 0; i < FLighterInputLatency::MaxTraces; ++i)
+		latency.Begin(ELighterInputSource::MoveRight, t);
+	TestFalse(TEXT("Overwritten trace isn't alive"), latency.IsAlive(pointer, t));
+
+	// 5. Reset clears the histograms
+	latency.Reset();
+	TestTrue(TEXT("Reset clears the histograms"), latency.GetHistogram(ELighterInputSource::Pointer, ELighterLatencyStage::Traced).Count == 0);
+	TestTrue(TEXT("Reset clears the trace counts"), latency.GetNumTraces(ELighterInputSource::MoveRight) == 0);
+	return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterLatencyWorldTest, "TheLighter.Latency.World",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterLatencyWorldTest::RunTest(const FString& Parameters)
+{
+	LIGHTER_ENABLE_INPUT_LATENCY();
+
+	FLighterTestWorld testWorld;
+	UWorld* world = testWorld.Get();
+	ULighterBlockSubsystem* subsystem = world->GetSubsystem<ULighterBlockSubsystem>();
+	FPhysScene* physScene = world->GetPhysicsScene();
+	UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+	if (!TestNotNull(TEXT("LighterBlockSubsystem"), subsystem) || !TestNotNull(TEXT("Physics scene"), physScene) || !TestNotNull(TEXT("Block mesh"), mesh))
+		return false;
+
+	const FTransform origin(FVector::ZeroVector);
+	ABlock* block = world->SpawnActorDeferred<ABlock>(ABlock::StaticClass(), origin, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	block->MeshComp->SetStaticMesh(mesh);
+	block->FinishSpawning(origin);
+
+	// The subsystem's first Tick hooks the physics pre-tick
+	const float deltaSeconds = 1.f / 60.f;
+	subsystem->Tick(deltaSeconds);
+
+	// A pointer sample arrives & becomes an emitter's aim (What the ball does with its own emitter)
+	FLighterInputLatency& latency = subsystem->GetInputLatency();
+	latency.Reset();
+	const uint32 pointer = latency.Begin(ELighterInputSource::Pointer, FPlatformTime::Seconds());
+	TestTrue(TEXT("Begin hands out a trace"), pointer != 0);
+
+	const int32 emitterId = subsystem->RegisterEmitter();
+	subsystem->SetEmitterInputTrace(emitterId, pointer);
+
+	// 1. The aim lights the block => Input => Tracer, the block carries the trace on
+	FLighterBlockSet hitSet;
+	hitSet.Add(block->BlockIndex);
+	subsystem->SetEmitterHits(emitterId, hitSet);
+
+	const FLighterLatencyHistogram& traced = latency.GetHistogram(ELighterInputSource::Pointer, ELighterLatencyStage::Traced);
+	const FLighterLatencyHistogram& collision = latency.GetHistogram(ELighterInputSource::Pointer, ELighterLatencyStage::Simulated);
+	TestTrue(TEXT("Tracer stamped"), traced.Count == 1);
+	TestTrue(TEXT("Tracer stamp is a real duration"), traced.MaxMs >= 0.0 && traced.MaxMs < FLighterInputLatency::MaxTraceMs);
+	TestTrue(TEXT("Lit block carries the trace"), subsystem->GetBlockInputTrace(block->BlockIndex) == pointer);
+	TestTrue(TEXT("No collision before the block is solid"), collision.Count == 0);
+
+	// 2. Resolved, but physics hasn't stepped yet
+	subsystem->Tick(deltaSeconds);
+	TestTrue(TEXT("Block went solid"), subsystem->IsBlockSolid(block->BlockIndex));
+	TestTrue(TEXT("No collision before the physics step"), collision.Count == 0);
+
+	// 3. The next physics step has it => Input => Collision, once
+	physScene->OnPhysScenePreTick.Broadcast(physScene, deltaSeconds);
+	TestTrue(TEXT("Collision stamped"), collision.Count == 1);
+	TestTrue(TEXT("Collision comes after the tracer"), collision.MaxMs >= traced.MaxMs);
+	physScene->OnPhysScenePreTick.Broadcast(physScene, deltaSeconds);
+	TestTrue(TEXT("Collision stamped once"), collision.Count == 1);
+
+	subsystem->UnregisterEmitter(emitterId);
+	subsystem->ResolveDirtyBlocks();
+	block->Destroy();
+	return true;
+}
+
+#undef LIGHTER_ENABLE_INPUT_LATENCY
+
+#endif
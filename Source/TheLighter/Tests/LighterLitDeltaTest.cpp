@@ -0,0 +1,108 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Automation tests for the bit-packed lit state delta
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Gameplay/LighterLitStateReplicator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Session Frontend => Automation => TheLighter.Net
+* Headless (No net driver, the server => client updates go through a fake connection):
+* 		UE4Editor-Cmd TheLighter.uproject -nullrhi -unattended -ExecCmds="Automation RunTests TheLighter.Net; Quit"
+*/
+
+// One server => client update over a fake connection
+// bDelivered false => The packet got lost, the base state stays on the last acked one (Same as the engine)
+static bool SendLitBits(FLighterLitBits& Server, FLighterLitBits& Client, TSharedPtr<INetDeltaBaseState>& BaseState, const bool bDelivered, int64& OutBits)
+{
+	FBitWriter writer(0, true);
+	TSharedPtr<INetDeltaBaseState> newState;
+
+	FNetDeltaSerializeInfo writeParms;
+	writeParms.Writer = &writer;
+	writeParms.OldState = BaseState.Get();
+	writeParms.NewState = &newState;
+
+	OutBits = 0;
+	if (!Server.NetDeltaSerialize(writeParms))
+		return false;
+
+	OutBits = writer.GetNumBits();
+	if (!bDelivered)
+		return true;
+
+	BaseState = newState;
+	FBitReader reader(writer.GetData(), writer.GetNumBits());
+	FNetDeltaSerializeInfo readParms;
+	readParms.Reader = &reader;
+	Client.NetDeltaSerialize(readParms);
+	return !reader.IsError();
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterLitDeltaTest, "TheLighter.Net.LitDelta",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterLitDeltaTest::RunTest(const FString& Parameters)
+{
+	// The test shouldn't show up in the live numbers (Lighter.Net.Stats)
+	const FLighterLitNetStats savedStats = FLighterLitBits::GetStats();
+
+	const int32 numBlocks = 5000;
+	FLighterLitBits server, client;
+	TSharedPtr<INetDeltaBaseState> baseState;
+	server.SetNum(numBlocks);
+
+	int64 bits = 0;
+	auto matches = [&]() { return client.NumBits == server.NumBits && client.Words == server.Words; };
+
+	// 1. Nothing lit, no base state => Full update, almost empty
+	TestTrue(TEXT("First update gets sent"), SendLitBits(server, client, baseState, true, bits));
+	TestTrue(TEXT("First update matches"), matches());
+	AddInfo(FString::Printf(TEXT("Full, nothing lit => %lld bits"), bits));
+
+	// 2. Nothing changed => Nothing sent
+	TestFalse(TEXT("No change sends nothing"), SendLitBits(server, client, baseState, true, bits));
+
+	// 3. A few blocks in one word => One word on the wire
+	server.Set(100, true);
+	server.Set(101, true);
+	server.Set(110, true);
+	TestTrue(TEXT("Small delta gets sent"), SendLitBits(server, client, baseState, true, bits));
+	TestTrue(TEXT("Small delta matches"), matches());
+	TestTrue(TEXT("Small delta lights its blocks"), client.Get(100) && client.Get(101) && client.Get(110));
+	TestFalse(TEXT("Small delta leaves the rest of the word"), client.Get(102));
+	TestTrue(FString::Printf(TEXT("Small delta is one word (%lld bits)"), bits), bits < 80);
+
+	// 4. Lost packet => The next delta is against the last acked state, so the client still ends up right
+	server.Set(4000, true);
+	SendLitBits(server, client, baseState, false, bits);
+	server.Set(100, false);
+	TestTrue(TEXT("Delta after a lost packet gets sent"), SendLitBits(server, client, baseState, true, bits));
+	TestTrue(TEXT("Delta after a lost packet matches"), matches());
+	TestTrue(TEXT("Delta after a lost packet carries the lost change"), client.Get(4000) && !client.Get(100));
+
+	// 5. 10% of the level lit at random
+	FRandomStream random(7);
+	for (int32 i = 0; i < numBlocks; ++i)
+		server.Set(i, random.FRand() < 0.1f);
+	TestTrue(TEXT("Busy delta gets sent"), SendLitBits(server, client, baseState, true, bits));
+	TestTrue(TEXT("Busy delta matches"), matches());
+	AddInfo(FString::Printf(TEXT("Delta, 10%% lit => %lld bits (Raw %d)"), bits, numBlocks));
+
+	// 6. Net order grew => Full update
+	server.SetNum(numBlocks + 40);
+	server.Set(numBlocks + 39, true);
+	TestTrue(TEXT("Resize gets sent"), SendLitBits(server, client, baseState, true, bits));
+	TestTrue(TEXT("Resize matches"), matches() && client.Get(numBlocks + 39));
+
+	FLighterLitBits::GetStats() = savedStats;
+	return true;
+}
+
+#endif
@@ -0,0 +1,94 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Automation tests for the lit / unlit fades written into the block custom data
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Gameplay/Block.h"
+#include "Gameplay/BlockField.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+#include "Gameplay/LighterLitVisuals.h"
+#include "Tests/LighterTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Session Frontend => Automation => TheLighter.LitVisuals
+* Headless (No rendering needed, only the custom data the CPU wrote is checked):
+* 		UE4Editor-Cmd TheLighter.uproject -nullrhi -unattended -ExecCmds="Automation RunTests TheLighter.LitVisuals; Quit"
+*/
+
+// The 4 floats at Offset => From & To (Lit factor), StartTime (Timestamp) & Duration
+static void TestFade(FAutomationTestBase& Test, const FString& What, const TArray<float>& Data, const int32 Offset, const FVector4& Expected)
+{
+	if (!Test.TestTrue(What + TEXT(" has the lit fade custom data"), Data.Num() >= Offset + LighterLitVisuals::Num))
+		return;
+
+	Test.TestEqual(What + TEXT(" From"), Data[Offset + LighterLitVisuals::From], Expected.X, KINDA_SMALL_NUMBER);
+	Test.TestEqual(What + TEXT(" To"), Data[Offset + LighterLitVisuals::To], Expected.Y, KINDA_SMALL_NUMBER);
+	Test.TestEqual(What + TEXT(" StartTime"), Data[Offset + LighterLitVisuals::StartTime], Expected.Z, KINDA_SMALL_NUMBER);
+	Test.TestEqual(What + TEXT(" Duration"), Data[Offset + LighterLitVisuals::Duration], Expected.W, KINDA_SMALL_NUMBER);
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterLitVisualsCustomDataTest, "TheLighter.LitVisuals.CustomData",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterLitVisualsCustomDataTest::RunTest(const FString& Parameters)
+{
+	FLighterTestWorld testWorld;
+	UWorld* world = testWorld.Get();
+	ULighterBlockSubsystem* subsystem = world->GetSubsystem<ULighterBlockSubsystem>();
+	UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+	if (!TestNotNull(TEXT("LighterBlockSubsystem"), subsystem) || !TestNotNull(TEXT("Block mesh"), mesh))
+		return false;
+
+	// An ABlock & a 2 instance ABlockField
+	const FTransform origin(FVector::ZeroVector);
+	ABlock* block = world->SpawnActorDeferred<ABlock>(ABlock::StaticClass(), origin, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	block->MeshComp->SetStaticMesh(mesh);
+	block->FinishSpawning(origin);
+
+	ABlockField* field = world->SpawnActorDeferred<ABlockField>(ABlockField::StaticClass(), origin, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	field->InstancedMeshComp->SetStaticMesh(mesh);
+	field->InstancedMeshComp->AddInstance(FTransform(FVector(0.f, 300.f, 0.f)));
+	field->InstancedMeshComp->AddInstance(FTransform(FVector(0.f, 600.f, 0.f)));
+	field->FinishSpawning(origin);
+
+	const float fadeSeconds = LighterLitVisuals::GetFadeSeconds();
+	const float time = world->GetTimeSeconds();
+	const int32 lastInstance = field->InstancedMeshComp->GetInstanceCount() - 1;
+	const int32 lastOffset = lastInstance * LighterLitVisuals::Num;
+
+	// 1. Lit from rest => 0 to 1, starting now
+	subsystem->SetTargetCollisionResponse(block->BlockIndex, ECR_Block);
+	subsystem->SetTargetCollisionResponse(field->GetBlockIndex(lastInstance), ECR_Block);
+	subsystem->FlushLitVisuals();
+
+	const FVector4 lit(0.f, 1.f, time, fadeSeconds);
+	TestFade(*this, TEXT("ABlock (Lit)"), block->MeshComp->GetCustomPrimitiveData().Data, 0, lit);
+	TestFade(*this, TEXT("ABlockField instance (Lit)"), field->InstancedMeshComp->PerInstanceSMCustomData, lastOffset, lit);
+
+	// The other instance is untouched
+	TestFade(*this, TEXT("ABlockField untouched instance"), field->InstancedMeshComp->PerInstanceSMCustomData, 0, FVector4(0.f, 0.f, 0.f, 0.f));
+
+	// 2. Unlit in the same frame => Picks up from where the fade is (Still 0 at the same time), heading to 0
+	subsystem->SetTargetCollisionResponse(block->BlockIndex, ECR_Overlap);
+	subsystem->FlushLitVisuals();
+	TestFade(*this, TEXT("ABlock (Unlit)"), block->MeshComp->GetCustomPrimitiveData().Data, 0, FVector4(LighterLitVisuals::Evaluate(lit, time), 0.f, time, fadeSeconds));
+
+	// 3. Same state again => Nothing new written
+	subsystem->SetTargetCollisionResponse(field->GetBlockIndex(lastInstance), ECR_Block);
+	subsystem->FlushLitVisuals();
+	TestFade(*this, TEXT("ABlockField instance (Relit)"), field->InstancedMeshComp->PerInstanceSMCustomData, lastOffset, lit);
+
+	subsystem->ResolveDirtyBlocks();
+	block->Destroy();
+	field->Destroy();
+	return true;
+}
+
+#endif
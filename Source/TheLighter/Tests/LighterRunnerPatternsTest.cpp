@@ -0,0 +1,84 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Automation tests for the seeded Runner patterns
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Math/RandomStream.h"
+#include "Gameplay/LighterRunnerPatterns.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Session Frontend => Automation => TheLighter.Runner
+* Headless (No world needed, the generator only reads its FRandomStream):
+* 		UE4Editor-Cmd TheLighter.uproject -nullrhi -unattended -ExecCmds="Automation RunTests TheLighter.Runner; Quit"
+*/
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterRunnerPatternsTest, "TheLighter.Runner.Patterns",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterRunnerPatternsTest::RunTest(const FString& Parameters)
+{
+	const int32 numPatterns = 1000;
+	const float spacing = 100.f, gap = 400.f, minZ = -300.f, maxZ = 900.f;
+
+	for (const int32 seed : { 1, 7, 12345 })
+	{
+		// 1000 patterns, twice from the same seed
+		FRandomStream first(seed), second(seed);
+		LighterRunnerPatterns::FLayout firstLayout, secondLayout;
+		FVector2D firstStart = FVector2D::ZeroVector, secondStart = FVector2D::ZeroVector;
+		int32 counts[(int32)ELighterRunnerPattern::Num] = {};
+		int32 mismatches = 0, outOfBand = 0, stalled = 0;
+
+		for (int32 i = 0; i < numPatterns; ++i)
+		{
+			firstLayout.Reset();
+			secondLayout.Reset();
+			const ELighterRunnerPattern firstPattern = LighterRunnerPatterns::Generate(first, firstStart, spacing, minZ, maxZ, firstLayout);
+			const ELighterRunnerPattern secondPattern = LighterRunnerPatterns::Generate(second, secondStart, spacing, minZ, maxZ, secondLayout);
+			++counts[(int32)firstPattern];
+
+			// Same seed => Same pattern, block for block
+			if (firstPattern != secondPattern || firstLayout.Blocks != secondLayout.Blocks || firstLayout.EndY != secondLayout.EndY || firstLayout.EndZ != secondLayout.EndZ)
+				++mismatches;
+
+			// Every block inside the band & ahead of where the pattern started
+			for (const FVector2D& block : firstLayout.Blocks)
+				if (block.Y < minZ || block.Y > maxZ || block.X < firstStart.X)
+					++outOfBand;
+
+			// The run always moves forward
+			if (firstLayout.EndY <= firstStart.X || firstLayout.Blocks.Num() == 0)
+				++stalled;
+
+			firstStart = FVector2D(firstLayout.EndY + gap, firstLayout.EndZ);
+			secondStart = FVector2D(secondLayout.EndY + gap, secondLayout.EndZ);
+		}
+
+		TestEqual(FString::Printf(TEXT("Seed %d => Both runs identical"), seed), mismatches, 0);
+		TestEqual(FString::Printf(TEXT("Seed %d => Every block inside the Z band"), seed), outOfBand, 0);
+		TestEqual(FString::Printf(TEXT("Seed %d => Every pattern moves the run forward"), seed), stalled, 0);
+
+		// Every pattern type actually comes up
+		for (int32 i = 0; i < (int32)ELighterRunnerPattern::Num; ++i)
+			TestTrue(FString::Printf(TEXT("Seed %d => %s patterns come up"), seed, LighterRunnerPatterns::GetName((ELighterRunnerPattern)i)), counts[i] > 0);
+	}
+
+	// A different seed => A different run
+	FRandomStream first(1), second(2);
+	LighterRunnerPatterns::FLayout firstLayout, secondLayout;
+	bool bDiffers = false;
+	for (int32 i = 0; i < 16 && !bDiffers; ++i)
+	{
+		firstLayout.Reset();
+		secondLayout.Reset();
+		LighterRunnerPatterns::Generate(first, FVector2D::ZeroVector, spacing, minZ, maxZ, firstLayout);
+		LighterRunnerPatterns::Generate(second, FVector2D::ZeroVector, spacing, minZ, maxZ, secondLayout);
+		bDiffers = firstLayout.Blocks != secondLayout.Blocks;
+	}
+	TestTrue(TEXT("Different seeds give different runs"), bDiffers);
+	return true;
+}
+
+#endif
@@ -0,0 +1,47 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Throwaway game world for the automation tests
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* A fresh game world for the length of one test, torn down when it goes out of scope
+* Subsystems, physics scene & BeginPlay included => Blocks & balls register like they do in a level
+*
+* NOTE: Nothing ticks it, the tests drive the Tracer & the subsystem by hand (Like Lighter.Benchmark does)
+*/
+
+class FLighterTestWorld
+{
+public:
+	FLighterTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("LighterTestWorld"));
+		World->AddToRoot();
+
+		FWorldContext& worldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		worldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FLighterTestWorld()
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+	}
+
+	FORCEINLINE UWorld* Get() const { return World; }
+
+private:
+	UWorld* World = nullptr;
+};
+
+#endif
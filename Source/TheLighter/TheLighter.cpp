@@ -3,5 +3,56 @@
 #include "TheLighter.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, TheLighter, "TheLighter" );
- 
\ No newline at end of file
+class FTheLighterModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		LLM(FLowLevelMemTracker::Get().RegisterProjectTag((int32)LLM_TAG_THELIGHTER, TEXT("TheLighter"), GET_STATFNAME(STAT_TheLighterLLM), GET_STATFNAME(STAT_TheLighterSummaryLLM)));
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FTheLighterModule, TheLighter, "TheLighter" );
+
+
+DEFINE_LOG_CATEGORY(LogTheLighter);
+
+CSV_DEFINE_CATEGORY(TheLighter, true);
+
+DEFINE_STAT(STAT_LighterBallTick);
+DEFINE_STAT(STAT_LighterInputQueries);
+DEFINE_STAT(STAT_LighterLerpTracer);
+DEFINE_STAT(STAT_LighterTraceCollision);
+DEFINE_STAT(STAT_LighterTraceSubsteps);
+DEFINE_STAT(STAT_LighterUpdateLitSet);
+DEFINE_STAT(STAT_LighterTraceGrounding);
+DEFINE_STAT(STAT_LighterTraceWalling);
+DEFINE_STAT(STAT_LighterAsyncProbes);
+DEFINE_STAT(STAT_LighterApplyExitImpulse);
+DEFINE_STAT(STAT_LighterStagePrelight);
+
+DEFINE_STAT(STAT_LighterResolveDirtyBlocks);
+DEFINE_STAT(STAT_LighterBlockResolveCollision);
+DEFINE_STAT(STAT_LighterBlockSetCollisionMode);
+DEFINE_STAT(STAT_LighterUpdateStreaming);
+DEFINE_STAT(STAT_LighterUpdateEmitters);
+DEFINE_STAT(STAT_LighterCaptureCheckpoint);
+DEFINE_STAT(STAT_LighterRestoreCheckpoint);
+
+DEFINE_STAT(STAT_LighterNetPackLitBits);
+DEFINE_STAT(STAT_LighterNetSerializeLitBits);
+
+DEFINE_STAT(STAT_LighterTraces);
+DEFINE_STAT(STAT_LighterPointerSamples);
+DEFINE_STAT(STAT_LighterLitBlocks);
+DEFINE_STAT(STAT_LighterCollisionToggles);
+DEFINE_STAT(STAT_LighterOverlapEvents);
+DEFINE_STAT(STAT_LighterExitImpulses);
+DEFINE_STAT(STAT_LighterEffectPoolHits);
+DEFINE_STAT(STAT_LighterEffectPoolMisses);
+DEFINE_STAT(STAT_LighterEffectPoolEvictions);
+DEFINE_STAT(STAT_LighterAwakeUnits);
+DEFINE_STAT(STAT_LighterStreamingOps);
+
+DEFINE_STAT(STAT_TheLighterLLM);
+DEFINE_STAT(STAT_TheLighterSummaryLLM);
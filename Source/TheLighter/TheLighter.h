@@ -3,3 +3,84 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+
+
+////////////////////////////////////////////////////////////////////// PROFILING
+// "stat TheLighter"	=> In-game stat group
+// -csvCategories=TheLighter	=> CSV profiler captures (csvprofile start/stop)
+// -trace=cpu			=> Unreal Insights scopes
+// -llm					=> Memory under the TheLighter LLM tag ("stat LLMFULL")
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTheLighter, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("TheLighter"), STATGROUP_TheLighter, STATCAT_Advanced);
+CSV_DECLARE_CATEGORY_EXTERN(TheLighter);
+
+// PlayerBall stages
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball Tick"), STAT_LighterBallTick, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball Input Queries"), STAT_LighterInputQueries, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball LerpTracerToTargetRotation"), STAT_LighterLerpTracer, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball TraceCollision"), STAT_LighterTraceCollision, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball TraceSubsteps"), STAT_LighterTraceSubsteps, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball UpdateLitSet"), STAT_LighterUpdateLitSet, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball TraceGrounding"), STAT_LighterTraceGrounding, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball TraceWalling"), STAT_LighterTraceWalling, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball Async Probes"), STAT_LighterAsyncProbes, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball ResolveExitImpulses"), STAT_LighterApplyExitImpulse, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ball StagePrelight"), STAT_LighterStagePrelight, STATGROUP_TheLighter, );
+
+// LighterBlock stages
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem ResolveDirtyBlocks"), STAT_LighterResolveDirtyBlocks, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Block ResolveCollision"), STAT_LighterBlockResolveCollision, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Block SetCollisionMode"), STAT_LighterBlockSetCollisionMode, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem UpdateStreaming"), STAT_LighterUpdateStreaming, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem UpdateEmitters"), STAT_LighterUpdateEmitters, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem CaptureCheckpoint"), STAT_LighterCaptureCheckpoint, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem RestoreCheckpoint"), STAT_LighterRestoreCheckpoint, STATGROUP_TheLighter, );
+
+// Co-op
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Net PackLitBits"), STAT_LighterNetPackLitBits, STATGROUP_TheLighter, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Net LitBits NetDeltaSerialize"), STAT_LighterNetSerializeLitBits, STATGROUP_TheLighter, );
+
+// Per-frame counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces"), STAT_LighterTraces, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pointer Samples"), STAT_LighterPointerSamples, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Lit Blocks"), STAT_LighterLitBlocks, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Collision Toggles"), STAT_LighterCollisionToggles, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Overlap Events"), STAT_LighterOverlapEvents, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Exit Impulses"), STAT_LighterExitImpulses, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effect Pool Hits"), STAT_LighterEffectPoolHits, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effect Pool Misses"), STAT_LighterEffectPoolMisses, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Effect Pool Evictions"), STAT_LighterEffectPoolEvictions, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Awake Streaming Units"), STAT_LighterAwakeUnits, STATGROUP_TheLighter, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Streaming Wakes & Sleeps"), STAT_LighterStreamingOps, STATGROUP_TheLighter, );
+
+
+// LLM
+// Everything TheLighter allocates on its own paths (Registries, scratch buffers, recordings)
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("TheLighter"), STAT_TheLighterLLM, STATGROUP_LLMFULL, );
+DECLARE_LLM_MEMORY_STAT_EXTERN(TEXT("TheLighter"), STAT_TheLighterSummaryLLM, STATGROUP_LLM, );
+
+#define LLM_TAG_THELIGHTER ((ELLMTag)((int32)ELLMTag::ProjectTagStart + 0))
+#define LIGHTER_LLM_SCOPE() LLM_SCOPE(LLM_TAG_THELIGHTER)
+
+
+// Cycle stat + Insights scope + CSV timing, all under the same name
+#define LIGHTER_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat); \
+	CSV_SCOPED_TIMING_STAT(TheLighter, Stat)
+
+// Counter stat + CSV custom stat, summed over the frame
+// One statement => Safe under a braceless if
+#define LIGHTER_INC_COUNTER(Stat, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(Stat, Amount); \
+		CSV_CUSTOM_STAT(TheLighter, Stat, (int32)(Amount), ECsvCustomStatOp::Accumulate); \
+	} while (0)
+////////////////////////////////////////////////////////////////////// PROFILING
@@ -2,9 +2,20 @@
 
 #include "TheLighterGameMode.h"
 #include "Gameplay/TheLighterBall.h"
+#include "Gameplay/LighterLitStateReplicator.h"
+#include "Engine/World.h"
 
 ATheLighterGameMode::ATheLighterGameMode()
 {
 	// set default pawn class to our ball
 	DefaultPawnClass = ATheLighterBall::StaticClass();
 }
+
+void ATheLighterGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Single player has nobody to share the puzzle with
+	if (GetNetMode() != NM_Standalone)
+		GetWorld()->SpawnActor<ALighterLitStateReplicator>();
+}
@@ -13,6 +13,9 @@ class ATheLighterGameMode : public AGameModeBase
 
 public:
 	ATheLighterGameMode();
+
+	// Networked games get the replicated LighterBlock lit state (See LighterLitStateReplicator.h)
+	virtual void BeginPlay() override;
 };
 
 
@@ -0,0 +1,896 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Headless microbenchmark for the Tracer-Algorithm
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Serialization/MemoryWriter.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SpotLightComponent.h"
+#include "Gameplay/TheLighterBall.h"
+#include "Gameplay/Block.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+#include "Gameplay/LighterVisibility.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/LighterTestWorld.h"
+#include "TheLighter.h"
+
+
+/*
+* Usage
+* -----
+* Lighter.Benchmark [MinBlocks=100] [MaxBlocks=100000] [Steps=360]
+*
+* Headless on Linux:
+* 		UE4Editor-Cmd TheLighter.uproject /Game/TheLigher/Maps/TestGameplay -game -nullrhi -unattended -nosound
+* 			-ExecCmds="Lighter.Benchmark 100 100000 360, quit"
+*
+* For every grid size (x10 from MinBlocks to MaxBlocks) and every TracerMode:
+* 1. Spawn a square grid of LighterBlocks on the YZ plane around a fresh PlayerBall
+* 2. Sweep the SpotLight one full turn in Steps increments
+* 3. Time each stage of the Tracer per step
+* 		Trace		=> Populate the HITSET
+* 		SetUpdate	=> HITSET vs LITSET diff
+* 		Resolve		=> LighterBlockSubsystem applying the collision changes
+*
+* Results go to the log & Saved/Profiling/TheLighter/Benchmark-<Timestamp>.csv
+*
+* Automation => TheLighter.Benchmark.TracerBudget (Same sweep in a throwaway world, fails past the bounds below)
+* 		UE4Editor-Cmd TheLighter.uproject -nullrhi -unattended -ExecCmds="Automation RunTests TheLighter.Benchmark; Quit"
+*
+*
+* Lighter.Benchmark.Toggles [NumBlocks=1000] [Rounds=20]
+*
+* Flips every block Solid <=> PassThrough Rounds times through the LighterBlockSubsystem
+* Once with Lighter.FastCollisionToggle 0 (Per-channel) & once with 1 (Container swap, one scene lock)
+* Reports toggles per millisecond for both
+*
+*
+* Lighter.Benchmark.Emitters [NumEmitters=8] [NumBlocks=10000] [Steps=360]
+*
+* NumEmitters Visibility cones around the grid center, each sweeping at its own phase
+* 		Independent	=> Every emitter runs its own grid query & visibility sweep, hands in a HITSET
+* 		Batched		=> Every emitter hands in its cone, ONE UpdateEmitters pass resolves them all
+* 		Cached		=> UpdateEmitters again with nothing moved (What static lamps cost)
+*
+*
+* Lighter.Benchmark.Store [NumBlocks=10000] [Rounds=100]
+*
+* The same bulk pass (Blocks in a box + how many are solid) done two ways, Rounds times
+* 		Actors	=> Reads the bounds & response off every ABlock (One UObject chase per block)
+* 		Store	=> Reads the LighterBlockSubsystem's FLighterBlockStore front to back
+* Reports ns per block for both
+*
+* NOTE: Wrap the run in "perf stat -e cache-misses,cache-references" for the miss counts, the pass timings line up with them
+*
+*
+* Lighter.Benchmark.Allocs [NumBlocks=10000] [Steps=360]
+*
+* Counts game thread heap allocations (Malloc & Realloc) over a full SpotLight sweep, one whole frame per step
+* One warm-up sweep first, so every scratch buffer has reached its steady-state size
+* 		BallTick		=> The ball's Tick (Input, Tracer, grounding & walling probes)
+* 		Prelight		=> The physics pre-tick (Prelight staging & commit)
+* 		SubsystemTick	=> The LighterBlockSubsystem's Tick (Exit impulses, streaming, emitters, resolve, lit visuals, staging expiry)
+* 		=> MUST all be zero for every TracerMode (RayFan included), logs FAILED otherwise
+*
+* Headless check:
+* 		-ExecCmds="Lighter.Benchmark.Allocs, quit" & grep the log for "Lighter.Benchmark.Allocs FAILED"
+*
+* Automation => TheLighter.Benchmark.ZeroAllocs (Same count in a throwaway world, fails on any allocation)
+*
+*
+* Lighter.Benchmark.Checkpoint [NumBlocks=10000] [Rounds=100]
+*
+* Two checkpoints with opposite lit patterns (Every block differs between them)
+* 		Capture		=> Snapshot of every block, emitter & ball
+* 		Restore		=> Back & forth between the two (Worst case, every block's body changes)
+* 		Unchanged	=> Restoring what's already there (Best case, nothing to diff out)
+* Logs a warning for any stage over 1 ms, plus the checkpoint's size serialized
+*/
+
+#if !UE_BUILD_SHIPPING
+// Forwards everything to the real allocator, counts game thread allocations while it's armed
+// Installed over GMalloc on first use & left in place (Pointers stay valid both ways)
+class FLighterCountingMalloc : public FMalloc
+{
+public:
+	static FLighterCountingMalloc& Get()
+	{
+		static FLighterCountingMalloc* instance = nullptr;
+		if (!instance)
+		{
+			instance = new FLighterCountingMalloc(GMalloc);
+			GMalloc = instance;
+		}
+		return *instance;
+	}
+
+	void Arm() { Count = 0; bArmed = true; }
+	uint64 Disarm() { bArmed = false; return Count; }
+
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Track(); return Inner->Malloc(Size, Alignment); }
+	virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { Track(); return Inner->Realloc(Ptr, NewSize, Alignment); }
+	virtual void Free(void* Ptr) override { Inner->Free(Ptr); }
+
+	virtual SIZE_T QuantizeSize(SIZE_T InCount, uint32 Alignment) override { return Inner->QuantizeSize(InCount, Alignment); }
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+	virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+	virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+	virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+	virtual void UpdateStats() override { Inner->UpdateStats(); }
+	virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+	virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+	virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+	virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+	virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+private:
+	explicit FLighterCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+	// Only the game thread is armed, so the count is a plain integer
+	FORCEINLINE void Track() { if (bArmed && IsInGameThread()) ++Count; }
+
+	FMalloc* Inner;
+	bool bArmed = false;
+	uint64 Count = 0;
+};
+#endif
+
+class FLighterBenchmark
+{
+public:
+	struct FStageTiming
+	{
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+		int32 Samples = 0;
+
+		void Add(const double Seconds)
+		{
+			TotalSeconds += Seconds;
+			MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+			++Samples;
+		}
+	};
+
+	static const TCHAR* GetModeName(const ETracerMode Mode)
+	{
+		switch (Mode)
+		{
+		case ETracerMode::ConeQuery:	return TEXT("ConeQuery");
+		case ETracerMode::Visibility:	return TEXT("Visibility");
+		default:						return TEXT("RayFan");
+		}
+	}
+
+	static void SpawnGrid(UWorld* World, UStaticMesh* Mesh, const int32 NumBlocks, const float Spacing, TArray<ABlock*>& OutBlocks)
+	{
+		const int32 side = FMath::CeilToInt(FMath::Sqrt((float)NumBlocks));
+		const float halfExtent = side * Spacing * 0.5f;
+
+		for (int32 i = 0; i < NumBlocks; ++i)
+		{
+			// Keep the ball's own cell clear, so it never starts inside a block
+			const FVector location(0.f, -halfExtent + (i % side) * Spacing, -halfExtent + (i / side) * Spacing);
+			if (location.Size() < Spacing)
+				continue;
+
+			ABlock* block = World->SpawnActorDeferred<ABlock>(ABlock::StaticClass(), FTransform(location), nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			block->MeshComp->SetStaticMesh(Mesh);
+			block->FinishSpawning(FTransform(location));
+			OutBlocks.Add(block);
+		}
+	}
+
+	// A ball at the grid's center that only ever moves its SpotLight
+	static ATheLighterBall* SpawnTracerBall(UWorld* World, const float Spacing)
+	{
+		FActorSpawnParameters spawnParams;
+		spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ATheLighterBall* ball = World->SpawnActor<ATheLighterBall>(ATheLighterBall::StaticClass(), FTransform(FVector::ZeroVector), spawnParams);
+		ball->Ball->SetSimulatePhysics(false);
+		ball->TraceAngle = ball->SpotLight->OuterConeAngle - ball->TraceAngleCorrection;
+		ball->TraceLength = FMath::Max(ball->TraceLength, Spacing * 10.f);
+		return ball;
+	}
+
+	// Rotate around X => Sweeps the cone across the YZ plane
+	static void SetSweepStep(ATheLighterBall* Ball, const int32 Step, const int32 Steps)
+	{
+		Ball->SpotLight->SetWorldRotation(FRotator(0.f, 90.f, 0.f) + FRotator(360.f * Step / Steps, 0.f, 0.f));
+	}
+
+	// One full SpotLight turn with the ball's current TracerMode, every stage timed per step
+	static void TimeSweep(ATheLighterBall* Ball, ULighterBlockSubsystem* Subsystem, const int32 Steps, FStageTiming& OutTrace, FStageTiming& OutSetUpdate, FStageTiming& OutResolve)
+	{
+		for (int32 step = 0; step < Steps; ++step)
+		{
+			SetSweepStep(Ball, step, Steps);
+
+			double start = FPlatformTime::Seconds();
+			Ball->HitSet.Reset();
+			Ball->TraceHitSet(Ball->HitSet);
+			OutTrace.Add(FPlatformTime::Seconds() - start);
+
+			start = FPlatformTime::Seconds();
+			Ball->UpdateLitSet();
+			OutSetUpdate.Add(FPlatformTime::Seconds() - start);
+
+			start = FPlatformTime::Seconds();
+			Subsystem->ResolveDirtyBlocks();
+			OutResolve.Add(FPlatformTime::Seconds() - start);
+		}
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Log(TEXT("Lighter.Benchmark needs a game world"));
+			return;
+		}
+
+		const int32 minBlocks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+		const int32 maxBlocks = Args.Num() > 1 ? FMath::Max(minBlocks, FCString::Atoi(*Args[1])) : 100000;
+		const int32 steps = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 360;
+
+		ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+		if (!subsystem || !mesh)
+		{
+			Ar.Log(TEXT("Lighter.Benchmark couldn't find the LighterBlockSubsystem or the block mesh"));
+			return;
+		}
+
+		const float spacing = 150.f;
+		FString csv = TEXT("Blocks,Mode,Stage,Steps,TotalMs,AvgUs,MaxUs\n");
+
+		for (int32 numBlocks = minBlocks; numBlocks <= maxBlocks; numBlocks *= 10)
+		{
+			TArray<ABlock*> blocks;
+			SpawnGrid(World, mesh, numBlocks, spacing, blocks);
+
+			ATheLighterBall* ball = SpawnTracerBall(World, spacing);
+			ball->NumberOfTraces = 8;
+
+			for (const ETracerMode mode : { ETracerMode::RayFan, ETracerMode::ConeQuery, ETracerMode::Visibility })
+			{
+				ball->TracerMode = mode;
+				FStageTiming trace, setUpdate, resolve;
+				TimeSweep(ball, subsystem, steps, trace, setUpdate, resolve);
+
+				const TPair<const TCHAR*, const FStageTiming*> stages[] = { { TEXT("Trace"), &trace }, { TEXT("SetUpdate"), &setUpdate }, { TEXT("Resolve"), &resolve } };
+				for (const TPair<const TCHAR*, const FStageTiming*>& stage : stages)
+				{
+					const FString line = FString::Printf(TEXT("%d,%s,%s,%d,%.3f,%.3f,%.3f"),
+						blocks.Num(), GetModeName(mode), stage.Key, stage.Value->Samples,
+						stage.Value->TotalSeconds * 1000.0,
+						stage.Value->TotalSeconds * 1000000.0 / FMath::Max(1, stage.Value->Samples),
+						stage.Value->MaxSeconds * 1000000.0);
+					Ar.Log(line);
+					csv += line + TEXT("\n");
+				}
+			}
+
+			ball->Destroy();
+			for (ABlock* block : blocks)
+				block->Destroy();
+		}
+
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Benchmark-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(csv, *csvPath))
+			Ar.Logf(TEXT("Lighter.Benchmark results written to %s"), *csvPath);
+	}
+
+	static void RunToggles(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Toggles needs a game world"));
+			return;
+		}
+
+		const int32 numBlocks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+		const int32 rounds = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 20;
+
+		ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+		IConsoleVariable* fastToggle = IConsoleManager::Get().FindConsoleVariable(TEXT("Lighter.FastCollisionToggle"));
+		if (!subsystem || !mesh || !fastToggle)
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Toggles couldn't find the LighterBlockSubsystem, the block mesh or Lighter.FastCollisionToggle"));
+			return;
+		}
+
+		TArray<ABlock*> blocks;
+		SpawnGrid(World, mesh, numBlocks, 150.f, blocks);
+
+		const int32 previousMode = fastToggle->GetInt();
+		FString csv = TEXT("Blocks,Path,Toggles,TotalMs,TogglesPerMs\n");
+
+		for (const int32 fast : { 0, 1 })
+		{
+			fastToggle->Set(fast, ECVF_SetByCode);
+
+			double totalSeconds = 0.0;
+			int32 toggles = 0;
+			for (int32 round = 0; round < rounds * 2; ++round)
+			{
+				// Even rounds => Solid, odd rounds => PassThrough (Every round flips every block)
+				const ECollisionResponse response = round % 2 == 0 ? ECR_Block : ECR_Overlap;
+				for (const ABlock* block : blocks)
+					subsystem->SetTargetCollisionResponse(block->BlockIndex, response);
+
+				toggles += subsystem->GetNumDirtyBlocks();
+				const double start = FPlatformTime::Seconds();
+				subsystem->ResolveDirtyBlocks();
+				totalSeconds += FPlatformTime::Seconds() - start;
+			}
+
+			const double totalMs = totalSeconds * 1000.0;
+			const FString line = FString::Printf(TEXT("%d,%s,%d,%.3f,%.1f"),
+				blocks.Num(), fast ? TEXT("ContainerSwap") : TEXT("PerChannel"), toggles, totalMs, toggles / FMath::Max(totalMs, 0.001));
+			Ar.Log(line);
+			csv += line + TEXT("\n");
+		}
+
+		fastToggle->Set(previousMode, ECVF_SetByCode);
+		for (ABlock* block : blocks)
+			block->Destroy();
+
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Toggles-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(csv, *csvPath))
+			Ar.Logf(TEXT("Lighter.Benchmark.Toggles results written to %s"), *csvPath);
+	}
+
+	static void RunEmitters(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Emitters needs a game world"));
+			return;
+		}
+
+		const int32 numEmitters = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 8;
+		const int32 numBlocks = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10000;
+		const int32 steps = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 360;
+
+		ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+		if (!subsystem || !mesh)
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Emitters couldn't find the LighterBlockSubsystem or the block mesh"));
+			return;
+		}
+
+		const float spacing = 150.f;
+		TArray<ABlock*> blocks;
+		SpawnGrid(World, mesh, numBlocks, spacing, blocks);
+
+		TArray<int32> emitterIds;
+		for (int32 i = 0; i < numEmitters; ++i)
+			emitterIds.Add(subsystem->RegisterEmitter());
+
+		// Emitters a few cells apart, so their cones overlap like co-op players & lamp rows do
+		auto getCone = [numEmitters, steps, spacing](const int32 Emitter, const int32 Step)
+		{
+			const float angle = 2.f * PI * ((float)Step / steps + (float)Emitter / numEmitters);
+			const FVector2D apex((Emitter - numEmitters * 0.5f) * spacing * 0.5f, 0.f);
+			return FLighterCone(apex, FVector2D(FMath::Cos(angle), FMath::Sin(angle)), 30.f, spacing * 10.f);
+		};
+
+		FStageTiming independent, batched, cached;
+		FLighterVisibility visibility;
+		FLighterBlockSet hitSet;
+		TArray<int32> candidates;
+		TArray<FBox2D> candidateBounds;
+		TArray<int32> visible;
+
+		for (int32 step = 0; step < steps; ++step)
+		{
+			double start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < numEmitters; ++i)
+			{
+				const FLighterCone cone = getCone(i, step);
+
+				candidates.Reset();
+				subsystem->QueryCone(cone, candidates);
+				candidateBounds.Reset();
+				for (const int32 blockIndex : candidates)
+					candidateBounds.Add(subsystem->GetBlockBounds(blockIndex));
+
+				visible.Reset();
+				visibility.Compute(cone, candidateBounds, visible);
+				hitSet.Reset();
+				for (const int32 candidate : visible)
+					hitSet.Add(candidates[candidate]);
+
+				subsystem->SetEmitterHits(emitterIds[i], hitSet);
+			}
+			independent.Add(FPlatformTime::Seconds() - start);
+
+			start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < numEmitters; ++i)
+				subsystem->SetEmitterCone(emitterIds[i], getCone(i, step), ELighterEmitterQuery::Visibility);
+			subsystem->UpdateEmitters();
+			batched.Add(FPlatformTime::Seconds() - start);
+
+			start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < numEmitters; ++i)
+				subsystem->SetEmitterCone(emitterIds[i], getCone(i, step), ELighterEmitterQuery::Visibility);
+			subsystem->UpdateEmitters();
+			cached.Add(FPlatformTime::Seconds() - start);
+
+			subsystem->ResolveDirtyBlocks();
+		}
+
+		FString csv = TEXT("Blocks,Emitters,Path,Steps,TotalMs,AvgUs,MaxUs\n");
+		const TPair<const TCHAR*, const FStageTiming*> paths[] = { { TEXT("Independent"), &independent }, { TEXT("Batched"), &batched }, { TEXT("Cached"), &cached } };
+		for (const TPair<const TCHAR*, const FStageTiming*>& path : paths)
+		{
+			const FString line = FString::Printf(TEXT("%d,%d,%s,%d,%.3f,%.3f,%.3f"),
+				blocks.Num(), numEmitters, path.Key, path.Value->Samples,
+				path.Value->TotalSeconds * 1000.0,
+				path.Value->TotalSeconds * 1000000.0 / FMath::Max(1, path.Value->Samples),
+				path.Value->MaxSeconds * 1000000.0);
+			Ar.Log(line);
+			csv += line + TEXT("\n");
+		}
+
+		for (const int32 emitterId : emitterIds)
+			subsystem->UnregisterEmitter(emitterId);
+		subsystem->ResolveDirtyBlocks();
+		for (ABlock* block : blocks)
+			block->Destroy();
+
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Emitters-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(csv, *csvPath))
+			Ar.Logf(TEXT("Lighter.Benchmark.Emitters results written to %s"), *csvPath);
+	}
+
+	static void RunStore(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Store needs a game world"));
+			return;
+		}
+
+		const int32 numBlocks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 rounds = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+
+		ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+		if (!subsystem || !mesh)
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Store couldn't find the LighterBlockSubsystem or the block mesh"));
+			return;
+		}
+
+		const float spacing = 150.f;
+		TArray<ABlock*> blocks;
+		SpawnGrid(World, mesh, numBlocks, spacing, blocks);
+
+		// Every other block solid, so both passes have real work to count
+		for (int32 i = 0; i < blocks.Num(); i += 2)
+			subsystem->SetTargetCollisionResponse(blocks[i]->BlockIndex, ECR_Block);
+		subsystem->ResolveDirtyBlocks();
+
+		// Quarter of the grid
+		const float halfExtent = FMath::Sqrt((float)numBlocks) * spacing * 0.5f;
+		const FBox2D box(FVector2D(-halfExtent, -halfExtent), FVector2D(0.f, 0.f));
+
+		FStageTiming actors, store;
+		int32 actorsInBox = 0, actorsSolid = 0, storeInBox = 0, storeSolid = 0;
+
+		for (int32 round = 0; round < rounds; ++round)
+		{
+			actorsInBox = actorsSolid = 0;
+			double start = FPlatformTime::Seconds();
+			for (const ABlock* block : blocks)
+			{
+				if (block->GetBounds2D().Intersect(box))
+					++actorsInBox;
+				if (block->MeshComp->BodyInstance.GetResponseToChannel(ECC_Pawn) == ECR_Block)
+					++actorsSolid;
+			}
+			actors.Add(FPlatformTime::Seconds() - start);
+
+			storeInBox = storeSolid = 0;
+			start = FPlatformTime::Seconds();
+			const FLighterBlockStore& blockStore = subsystem->GetStore();
+			for (int32 blockIndex = 0; blockIndex < blockStore.Num(); ++blockIndex)
+			{
+				if (!blockStore.IsValid(blockIndex)) continue;
+				if (blockStore.Intersects(blockIndex, box))
+					++storeInBox;
+				if (blockStore.IsSolid(blockIndex))
+					++storeSolid;
+			}
+			store.Add(FPlatformTime::Seconds() - start);
+		}
+
+		if (actorsInBox != storeInBox || actorsSolid != storeSolid)
+			Ar.Logf(TEXT("Lighter.Benchmark.Store passes disagree (InBox %d vs %d, Solid %d vs %d)"), actorsInBox, storeInBox, actorsSolid, storeSolid);
+
+		FString csv = TEXT("Blocks,Pass,Rounds,TotalMs,AvgUs,NsPerBlock\n");
+		const TPair<const TCHAR*, const FStageTiming*> passes[] = { { TEXT("Actors"), &actors }, { TEXT("Store"), &store } };
+		for (const TPair<const TCHAR*, const FStageTiming*>& pass : passes)
+		{
+			const FString line = FString::Printf(TEXT("%d,%s,%d,%.3f,%.3f,%.2f"),
+				blocks.Num(), pass.Key, pass.Value->Samples,
+				pass.Value->TotalSeconds * 1000.0,
+				pass.Value->TotalSeconds * 1000000.0 / FMath::Max(1, pass.Value->Samples),
+				pass.Value->TotalSeconds * 1000000000.0 / FMath::Max(1, pass.Value->Samples * blocks.Num()));
+			Ar.Log(line);
+			csv += line + TEXT("\n");
+		}
+
+		for (ABlock* block : blocks)
+			block->Destroy();
+
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Store-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(csv, *csvPath))
+			Ar.Logf(TEXT("Lighter.Benchmark.Store results written to %s"), *csvPath);
+	}
+
+#if !UE_BUILD_SHIPPING
+	// Game thread allocations per stage of a frame over one full SpotLight turn, after a warm-up turn
+	// Ball tick => Physics pre-tick => Subsystem tick, in the order the world runs them
+	// NOTE: Synchronous probes only, async traces land in the world's tick (Which isn't ours to count)
+	static void CountSweepAllocs(ATheLighterBall* Ball, ULighterBlockSubsystem* Subsystem, const int32 Steps, uint64& OutBall, uint64& OutPrelight, uint64& OutSubsystem)
+	{
+		FLighterCountingMalloc& counter = FLighterCountingMalloc::Get();
+		FPhysScene* physScene = Ball->GetWorld()->GetPhysicsScene();
+		const float deltaSeconds = 1.f / 60.f;
+		OutBall = OutPrelight = OutSubsystem = 0;
+
+		// Sweep 0 => Warm-up (The subsystem also hooks the physics pre-tick on its first Tick), Sweep 1 => Counted
+		for (int32 sweep = 0; sweep < 2; ++sweep)
+		{
+			for (int32 step = 0; step < Steps; ++step)
+			{
+				// Target = Where we put it => The Tick's lerp leaves the sweep alone
+				SetSweepStep(Ball, step, Steps);
+				Ball->SetTracerRotation(Ball->SpotLight->GetForwardVector());
+
+				counter.Arm();
+				Ball->Tick(deltaSeconds);
+				const uint64 ballCount = counter.Disarm();
+
+				counter.Arm();
+				if (physScene)
+					physScene->OnPhysScenePreTick.Broadcast(physScene, deltaSeconds);
+				const uint64 prelightCount = counter.Disarm();
+
+				counter.Arm();
+				Subsystem->Tick(deltaSeconds);
+				const uint64 subsystemCount = counter.Disarm();
+
+				if (sweep == 1)
+				{
+					OutBall += ballCount;
+					OutPrelight += prelightCount;
+					OutSubsystem += subsystemCount;
+				}
+			}
+		}
+	}
+#endif
+
+	static void RunAllocs(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+#if UE_BUILD_SHIPPING
+		Ar.Log(TEXT("Lighter.Benchmark.Allocs isn't available in Shipping"));
+#else
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Allocs needs a game world"));
+			return;
+		}
+
+		const int32 numBlocks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 steps = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 360;
+
+		ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+		if (!subsystem || !mesh)
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Allocs couldn't find the LighterBlockSubsystem or the block mesh"));
+			return;
+		}
+
+		const float spacing = 150.f;
+		TArray<ABlock*> blocks;
+		SpawnGrid(World, mesh, numBlocks, spacing, blocks);
+
+		ATheLighterBall* ball = SpawnTracerBall(World, spacing);
+		ball->bAsyncProbes = false;
+
+		bool bFailed = false;
+		FString csv = TEXT("Blocks,Mode,Stage,Steps,Allocations\n");
+
+		for (const ETracerMode mode : { ETracerMode::RayFan, ETracerMode::ConeQuery, ETracerMode::Visibility })
+		{
+			ball->TracerMode = mode;
+			uint64 ballTick = 0, prelight = 0, subsystemTick = 0;
+			CountSweepAllocs(ball, subsystem, steps, ballTick, prelight, subsystemTick);
+
+			if (ballTick + prelight + subsystemTick > 0)
+				bFailed = true;
+
+			const TPair<const TCHAR*, uint64> stages[] = { { TEXT("BallTick"), ballTick }, { TEXT("Prelight"), prelight }, { TEXT("SubsystemTick"), subsystemTick } };
+			for (const TPair<const TCHAR*, uint64>& stage : stages)
+			{
+				const FString line = FString::Printf(TEXT("%d,%s,%s,%d,%llu"), blocks.Num(), GetModeName(mode), stage.Key, steps, stage.Value);
+				Ar.Log(line);
+				csv += line + TEXT("\n");
+			}
+		}
+
+		ball->Destroy();
+		for (ABlock* block : blocks)
+			block->Destroy();
+
+		if (bFailed)
+			UE_LOG(LogTheLighter, Error, TEXT("Lighter.Benchmark.Allocs FAILED => The steady-state frame allocated (See the counts above)"));
+		else
+			UE_LOG(LogTheLighter, Log, TEXT("Lighter.Benchmark.Allocs PASSED => No steady-state frame allocations"));
+
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Allocs-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(csv, *csvPath))
+			Ar.Logf(TEXT("Lighter.Benchmark.Allocs results written to %s"), *csvPath);
+#endif
+	}
+	static void RunCheckpoint(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Checkpoint needs a game world"));
+			return;
+		}
+
+		const int32 numBlocks = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const int32 rounds = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+
+		ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+		if (!subsystem || !mesh)
+		{
+			Ar.Log(TEXT("Lighter.Benchmark.Checkpoint couldn't find the LighterBlockSubsystem or the block mesh"));
+			return;
+		}
+
+		TArray<ABlock*> blocks;
+		SpawnGrid(World, mesh, numBlocks, 150.f, blocks);
+
+		// Even blocks lit in A, odd ones in B
+		const int32 emitterId = subsystem->RegisterEmitter();
+		FLighterCheckpoint checkpoints[2];
+		FLighterBlockSet hitSet;
+		for (int32 pattern = 0; pattern < 2; ++pattern)
+		{
+			hitSet.Reset();
+			for (int32 i = pattern; i < blocks.Num(); i += 2)
+				hitSet.Add(blocks[i]->BlockIndex);
+			subsystem->SetEmitterHits(emitterId, hitSet);
+			subsystem->ResolveDirtyBlocks();
+			subsystem->CaptureCheckpoint(checkpoints[pattern]);
+		}
+
+		FStageTiming capture, restore, unchanged;
+		FLighterCheckpoint scratch;
+		for (int32 round = 0; round < rounds; ++round)
+		{
+			double start = FPlatformTime::Seconds();
+			subsystem->CaptureCheckpoint(scratch);
+			capture.Add(FPlatformTime::Seconds() - start);
+
+			start = FPlatformTime::Seconds();
+			subsystem->RestoreCheckpoint(checkpoints[round % 2]);
+			restore.Add(FPlatformTime::Seconds() - start);
+
+			start = FPlatformTime::Seconds();
+			subsystem->RestoreCheckpoint(checkpoints[round % 2]);
+			unchanged.Add(FPlatformTime::Seconds() - start);
+		}
+
+		// The last restore has to have brought its whole pattern back
+		const int32 lastPattern = (rounds - 1) % 2;
+		int32 mismatches = 0;
+		for (int32 i = 0; i < blocks.Num(); ++i)
+			mismatches += subsystem->IsBlockSolid(blocks[i]->BlockIndex) != (i % 2 == lastPattern) ? 1 : 0;
+		if (mismatches > 0)
+			UE_LOG(LogTheLighter, Error, TEXT("Lighter.Benchmark.Checkpoint => %d blocks didn't come back as captured"), mismatches);
+
+		TArray<uint8> bytes;
+		FMemoryWriter writer(bytes);
+		writer << checkpoints[0];
+
+		FString csv = TEXT("Blocks,Stage,Rounds,AvgUs,MaxUs,Bytes\n");
+		const TPair<const TCHAR*, const FStageTiming*> stages[] = { { TEXT("Capture"), &capture }, { TEXT("Restore"), &restore }, { TEXT("Unchanged"), &unchanged } };
+		for (const TPair<const TCHAR*, const FStageTiming*>& stage : stages)
+		{
+			const FString line = FString::Printf(TEXT("%d,%s,%d,%.3f,%.3f,%d"),
+				blocks.Num(), stage.Key, stage.Value->Samples,
+				stage.Value->TotalSeconds * 1000000.0 / FMath::Max(1, stage.Value->Samples),
+				stage.Value->MaxSeconds * 1000000.0,
+				bytes.Num());
+			Ar.Log(line);
+			csv += line + TEXT("\n");
+
+			if (stage.Value->MaxSeconds > 0.001)
+				UE_LOG(LogTheLighter, Warning, TEXT("Lighter.Benchmark.Checkpoint => %s went over 1 ms (%.3f ms)"), stage.Key, stage.Value->MaxSeconds * 1000.0);
+		}
+
+		subsystem->UnregisterEmitter(emitterId);
+		subsystem->ResolveDirtyBlocks();
+		for (ABlock* block : blocks)
+			block->Destroy();
+
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Checkpoint-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(csv, *csvPath))
+			Ar.Logf(TEXT("Lighter.Benchmark.Checkpoint results written to %s"), *csvPath);
+	}
+};
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterBenchmarkCommand(
+	TEXT("Lighter.Benchmark"),
+	TEXT("Times the Tracer stages over synthetic LighterBlock grids. Args: [MinBlocks=100] [MaxBlocks=100000] [Steps=360]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBenchmark::Run));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterToggleBenchmarkCommand(
+	TEXT("Lighter.Benchmark.Toggles"),
+	TEXT("Toggles per ms of the per-channel vs the container-swap collision path. Args: [NumBlocks=1000] [Rounds=20]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBenchmark::RunToggles));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterEmitterBenchmarkCommand(
+	TEXT("Lighter.Benchmark.Emitters"),
+	TEXT("Independent vs batched vs cached resolution of many light emitters. Args: [NumEmitters=8] [NumBlocks=10000] [Steps=360]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBenchmark::RunEmitters));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterStoreBenchmarkCommand(
+	TEXT("Lighter.Benchmark.Store"),
+	TEXT("Bulk pass over the block actors vs over the packed block store. Args: [NumBlocks=10000] [Rounds=100]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBenchmark::RunStore));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterAllocsBenchmarkCommand(
+	TEXT("Lighter.Benchmark.Allocs"),
+	TEXT("Counts steady-state heap allocations of a ball & subsystem frame, fails on any. Args: [NumBlocks=10000] [Steps=360]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBenchmark::RunAllocs));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterCheckpointBenchmarkCommand(
+	TEXT("Lighter.Benchmark.Checkpoint"),
+	TEXT("Times checkpoint capture & restore, worst & best case. Args: [NumBlocks=10000] [Rounds=100]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBenchmark::RunCheckpoint));
+
+
+
+#if WITH_DEV_AUTOMATION_TESTS
+/*
+* The Lighter.Benchmark sweep, with pass / fail bounds
+* 		Budget	=> Trace + SetUpdate + Resolve under TracerBudgetMs a step, for every TracerMode at the large grid
+* 		Scaling	=> 100x the blocks, the Trace may cost at most TracerScalingFactor x more (The grid keeps it to what the cone covers)
+*/
+
+static const int32 TracerTestSmallGrid = 100;
+static const int32 TracerTestLargeGrid = 10000;
+static const int32 TracerTestSteps = 360;
+static const double TracerBudgetMs = 1.0;
+static const double TracerScalingFactor = 4.0;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterTracerBudgetTest, "TheLighter.Benchmark.TracerBudget",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FLighterTracerBudgetTest::RunTest(const FString& Parameters)
+{
+	FLighterTestWorld testWorld;
+	UWorld* world = testWorld.Get();
+	ULighterBlockSubsystem* subsystem = world->GetSubsystem<ULighterBlockSubsystem>();
+	UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+	if (!TestNotNull(TEXT("LighterBlockSubsystem"), subsystem) || !TestNotNull(TEXT("Block mesh"), mesh))
+		return false;
+
+	const float spacing = 150.f;
+	const ETracerMode modes[] = { ETracerMode::RayFan, ETracerMode::ConeQuery, ETracerMode::Visibility };
+	double traceMs[2][UE_ARRAY_COUNT(modes)];
+	double totalMs[2][UE_ARRAY_COUNT(modes)];
+
+	const int32 grids[] = { TracerTestSmallGrid, TracerTestLargeGrid };
+	for (int32 grid = 0; grid < 2; ++grid)
+	{
+		TArray<ABlock*> blocks;
+		FLighterBenchmark::SpawnGrid(world, mesh, grids[grid], spacing, blocks);
+		ATheLighterBall* ball = FLighterBenchmark::SpawnTracerBall(world, spacing);
+		ball->NumberOfTraces = 8;
+
+		for (int32 mode = 0; mode < UE_ARRAY_COUNT(modes); ++mode)
+		{
+			ball->TracerMode = modes[mode];
+
+			// One warm-up turn => Scratch buffers & the physics scene's caches are where they'd be in play
+			FLighterBenchmark::FStageTiming trace, setUpdate, resolve;
+			FLighterBenchmark::TimeSweep(ball, subsystem, TracerTestSteps, trace, setUpdate, resolve);
+			trace = setUpdate = resolve = FLighterBenchmark::FStageTiming();
+			FLighterBenchmark::TimeSweep(ball, subsystem, TracerTestSteps, trace, setUpdate, resolve);
+
+			traceMs[grid][mode] = trace.TotalSeconds * 1000.0 / TracerTestSteps;
+			totalMs[grid][mode] = (trace.TotalSeconds + setUpdate.TotalSeconds + resolve.TotalSeconds) * 1000.0 / TracerTestSteps;
+			AddInfo(FString::Printf(TEXT("%s, %d blocks => Trace %.3f ms, Total %.3f ms a step"),
+				FLighterBenchmark::GetModeName(modes[mode]), blocks.Num(), traceMs[grid][mode], totalMs[grid][mode]));
+		}
+
+		ball->Destroy();
+		subsystem->ResolveDirtyBlocks();
+		for (ABlock* block : blocks)
+			block->Destroy();
+	}
+
+	for (int32 mode = 0; mode < UE_ARRAY_COUNT(modes); ++mode)
+	{
+		const TCHAR* modeName = FLighterBenchmark::GetModeName(modes[mode]);
+		TestTrue(FString::Printf(TEXT("%s stays under %.1f ms a step at %d blocks (%.3f ms)"), modeName, TracerBudgetMs, TracerTestLargeGrid, totalMs[1][mode]),
+			totalMs[1][mode] < TracerBudgetMs);
+
+		// Small absolute slack => Timer resolution can't fail a sub-microsecond trace
+		TestTrue(FString::Printf(TEXT("%s Trace doesn't scale with the block count (%.3f => %.3f ms)"), modeName, traceMs[0][mode], traceMs[1][mode]),
+			traceMs[1][mode] < traceMs[0][mode] * TracerScalingFactor + 0.02);
+	}
+	return true;
+}
+
+
+
+#if !UE_BUILD_SHIPPING
+/*
+* The Lighter.Benchmark.Allocs count, with a pass / fail
+* Every TracerMode (The default RayFan too) => A whole ball tick, physics pre-tick & subsystem tick without a single steady-state allocation
+*/
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLighterZeroAllocsTest, "TheLighter.Benchmark.ZeroAllocs",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FLighterZeroAllocsTest::RunTest(const FString& Parameters)
+{
+	FLighterTestWorld testWorld;
+	UWorld* world = testWorld.Get();
+	ULighterBlockSubsystem* subsystem = world->GetSubsystem<ULighterBlockSubsystem>();
+	UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+	if (!TestNotNull(TEXT("LighterBlockSubsystem"), subsystem) || !TestNotNull(TEXT("Block mesh"), mesh))
+		return false;
+
+	const float spacing = 150.f;
+	TArray<ABlock*> blocks;
+	FLighterBenchmark::SpawnGrid(world, mesh, TracerTestLargeGrid, spacing, blocks);
+	ATheLighterBall* ball = FLighterBenchmark::SpawnTracerBall(world, spacing);
+	ball->bAsyncProbes = false;
+
+	for (const ETracerMode mode : { ETracerMode::RayFan, ETracerMode::ConeQuery, ETracerMode::Visibility })
+	{
+		ball->TracerMode = mode;
+		uint64 ballTick = 0, prelight = 0, subsystemTick = 0;
+		FLighterBenchmark::CountSweepAllocs(ball, subsystem, TracerTestSteps, ballTick, prelight, subsystemTick);
+
+		const TCHAR* modeName = FLighterBenchmark::GetModeName(mode);
+		TestTrue(FString::Printf(TEXT("%s ball tick doesn't allocate (%llu)"), modeName, ballTick), ballTick == 0);
+		TestTrue(FString::Printf(TEXT("%s physics pre-tick doesn't allocate (%llu)"), modeName, prelight), prelight == 0);
+		TestTrue(FString::Printf(TEXT("%s subsystem tick doesn't allocate (%llu)"), modeName, subsystemTick), subsystemTick == 0);
+	}
+
+	ball->Destroy();
+	subsystem->ResolveDirtyBlocks();
+	for (ABlock* block : blocks)
+		block->Destroy();
+	return true;
+}
+#endif
+#endif
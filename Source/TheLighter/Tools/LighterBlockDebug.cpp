@@ -0,0 +1,167 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Console tooling for the LighterBlock state
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "DrawDebugHelpers.h"
+#include "Serialization/MemoryWriter.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+
+
+/*
+* Usage
+* -----
+* Lighter.Blocks.Summary
+* 		Blocks / Solid / Pending / Parked / Lit / Dirty totals
+*
+* Lighter.Blocks.Draw [Seconds=5] [X=0]
+* 		Every block's YZ bounds at X
+* 		Green => Solid, Yellow => Pending change, Red => Parked (A ball's inside), Grey => PassThrough
+*
+* Both read the LighterBlockSubsystem's FLighterBlockStore in ONE linear pass, no actor is touched
+*
+* Lighter.Checkpoint.Save / Lighter.Checkpoint.Load
+* 		The LighterBlockSubsystem's respawn checkpoint (Same as the PlayerBall's SaveCheckpoint / LoadCheckpoint)
+*
+* Lighter.Prelight.Stats [Reset]
+* 		Lit => Solid latency since the last Reset, in frames (0 => The same frame's physics had it) & ms
+* 		Staged (Pre-lit) & unstaged blocks apart, so "Lighter.Prelight 0" vs "1" on the same run shows the difference
+*/
+
+class FLighterBlockDebug
+{
+public:
+	static ULighterBlockSubsystem* GetSubsystem(UWorld* World, FOutputDevice& Ar, const TCHAR* Command)
+	{
+		ULighterBlockSubsystem* subsystem = World && World->IsGameWorld() ? World->GetSubsystem<ULighterBlockSubsystem>() : nullptr;
+		if (!subsystem)
+			Ar.Logf(TEXT("%s needs a game world with a LighterBlockSubsystem"), Command);
+		return subsystem;
+	}
+
+	static void Summary(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const ULighterBlockSubsystem* subsystem = GetSubsystem(World, Ar, TEXT("Lighter.Blocks.Summary"));
+		if (!subsystem) return;
+
+		const FLighterBlockStore::FSummary summary = subsystem->GetStore().Summarize();
+		Ar.Logf(TEXT("Blocks %d | Solid %d | Pending %d | Parked %d | Lit %d | Dirty %d"),
+			summary.NumBlocks, summary.NumSolid, summary.NumPending, summary.NumParked, summary.NumLit, subsystem->GetNumDirtyBlocks());
+	}
+
+	static void Draw(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const ULighterBlockSubsystem* subsystem = GetSubsystem(World, Ar, TEXT("Lighter.Blocks.Draw"));
+		if (!subsystem) return;
+
+		const float seconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 5.f;
+		const float x = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.f;
+
+		const FLighterBlockStore& store = subsystem->GetStore();
+		for (int32 blockIndex = 0; blockIndex < store.Num(); ++blockIndex)
+		{
+			if (!store.IsValid(blockIndex)) continue;
+
+			const FColor color =
+				store.IsParked(blockIndex) ? FColor::Red :
+				store.HasPendingChange(blockIndex) ? FColor::Yellow :
+				store.IsSolid(blockIndex) ? FColor::Green : FColor(128, 128, 128);
+
+			const FBox2D bounds = store.GetBounds(blockIndex);
+			DrawDebugBox(World, FVector(x, bounds.GetCenter().X, bounds.GetCenter().Y), FVector(1.f, bounds.GetExtent().X, bounds.GetExtent().Y), color, false, seconds);
+		}
+	}
+
+	static void SaveCheckpoint(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		ULighterBlockSubsystem* subsystem = GetSubsystem(World, Ar, TEXT("Lighter.Checkpoint.Save"));
+		if (!subsystem) return;
+
+		const double start = FPlatformTime::Seconds();
+		subsystem->SaveCheckpoint();
+		const double seconds = FPlatformTime::Seconds() - start;
+
+		// Size on disk, off a copy (The archive wants it mutable)
+		FLighterCheckpoint checkpoint = subsystem->GetCheckpoint();
+		TArray<uint8> bytes;
+		FMemoryWriter writer(bytes);
+		writer << checkpoint;
+		Ar.Logf(TEXT("Checkpoint saved in %.3f ms (%d blocks, %d balls, %d bytes serialized)"),
+			seconds * 1000.0, subsystem->GetNumBlocks(), checkpoint.Balls.Num(), bytes.Num());
+	}
+
+	static void LoadCheckpoint(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		ULighterBlockSubsystem* subsystem = GetSubsystem(World, Ar, TEXT("Lighter.Checkpoint.Load"));
+		if (!subsystem) return;
+
+		const double start = FPlatformTime::Seconds();
+		if (subsystem->LoadCheckpoint())
+			Ar.Logf(TEXT("Checkpoint restored in %.3f ms"), (FPlatformTime::Seconds() - start) * 1000.0);
+		else
+			Ar.Logf(TEXT("No checkpoint saved yet (Lighter.Checkpoint.Save)"));
+	}
+
+	static void PrelightStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		ULighterBlockSubsystem* subsystem = GetSubsystem(World, Ar, TEXT("Lighter.Prelight.Stats"));
+		if (!subsystem) return;
+
+		if (Args.Num() > 0 && Args[0] == TEXT("Reset"))
+		{
+			subsystem->ResetPrelightStats();
+			Ar.Logf(TEXT("Lighter.Prelight.Stats reset"));
+			return;
+		}
+
+		const FLighterPrelightStats& stats = subsystem->GetPrelightStats();
+		Ar.Logf(TEXT("Prelight %s (%d frames ahead) | Staged now %d | Staged %u | Committed %u"),
+			ULighterBlockSubsystem::GetPrelightFrames() > 0 ? TEXT("ON") : TEXT("OFF"), ULighterBlockSubsystem::GetPrelightFrames(),
+			subsystem->GetNumStagedBlocks(), stats.Staged, stats.Committed);
+
+		const TCHAR* names[] = { TEXT("Unstaged"), TEXT("Staged  ") };
+		for (int32 staged = 0; staged < 2; ++staged)
+		{
+			uint32 samples = 0;
+			uint64 totalFrames = 0;
+			FString buckets;
+			for (int32 frames = 0; frames < FLighterPrelightStats::MaxFrames; ++frames)
+			{
+				samples += stats.Frames[staged][frames];
+				totalFrames += (uint64)stats.Frames[staged][frames] * frames;
+				buckets += FString::Printf(TEXT(" | %d%s: %u"), frames, frames == FLighterPrelightStats::MaxFrames - 1 ? TEXT("+") : TEXT(""), stats.Frames[staged][frames]);
+			}
+
+			Ar.Logf(TEXT("%s => %u blocks | Avg %.2f frames, %.2f ms | Max %.2f ms%s"), names[staged], samples,
+				samples ? (double)totalFrames / samples : 0.0, samples ? stats.TotalMs[staged] / samples : 0.0, stats.MaxMs[staged], *buckets);
+		}
+	}
+};
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterBlocksSummaryCommand(
+	TEXT("Lighter.Blocks.Summary"),
+	TEXT("Totals of the LighterBlock state (Solid, pending, parked, lit, dirty)"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBlockDebug::Summary));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterBlocksDrawCommand(
+	TEXT("Lighter.Blocks.Draw"),
+	TEXT("Draws every LighterBlock colored by its state. Args: [Seconds=5] [X=0]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBlockDebug::Draw));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterCheckpointSaveCommand(
+	TEXT("Lighter.Checkpoint.Save"),
+	TEXT("Snapshots the blocks, emitters & balls as the respawn checkpoint"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBlockDebug::SaveCheckpoint));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterCheckpointLoadCommand(
+	TEXT("Lighter.Checkpoint.Load"),
+	TEXT("Restores the last respawn checkpoint in place"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBlockDebug::LoadCheckpoint));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterPrelightStatsCommand(
+	TEXT("Lighter.Prelight.Stats"),
+	TEXT("Lit => Solid latency (Frames & ms), staged vs unstaged blocks. Args: [Reset]"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterBlockDebug::PrelightStats));
@@ -0,0 +1,46 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Console tooling for the pooled effects
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Particles/ParticleSystem.h"
+#include "Gameplay/LighterEffectPool.h"
+#include "Gameplay/LighterEffectSubsystem.h"
+
+
+/*
+* Usage
+* -----
+* Lighter.Effects.Stats
+* 		Per effect type => Slots / Active / Free & Hits / Misses / Evictions so far
+*/
+
+class FLighterEffectsDebug
+{
+public:
+	static void Stats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const ULighterEffectSubsystem* subsystem = World && World->IsGameWorld() ? World->GetSubsystem<ULighterEffectSubsystem>() : nullptr;
+		if (!subsystem)
+		{
+			Ar.Logf(TEXT("Lighter.Effects.Stats needs a game world with a LighterEffectSubsystem"));
+			return;
+		}
+
+		for (const TPair<UParticleSystem*, FLighterEffectPoolEntry>& pool : subsystem->GetPools())
+		{
+			const FLighterEffectPool& effectPool = pool.Value.Pool;
+			const FLighterEffectPool::FStats& stats = effectPool.GetStats();
+			Ar.Logf(TEXT("%s | Slots %d / %d | Active %d | Free %d | Hits %u | Misses %u | Evictions %u"),
+				*GetNameSafe(pool.Key), effectPool.GetNumSlots(), effectPool.GetMaxInstances(), effectPool.GetNumActive(), effectPool.GetNumFree(),
+				stats.Hits, stats.Misses, stats.Evictions);
+		}
+	}
+};
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterEffectsStatsCommand(
+	TEXT("Lighter.Effects.Stats"),
+	TEXT("Per effect type pool usage (Slots, active, hits, misses, evictions)"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterEffectsDebug::Stats));
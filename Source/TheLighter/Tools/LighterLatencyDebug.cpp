@@ -0,0 +1,111 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Console tooling for the input => effect latency
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Gameplay/LighterInputLatency.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+
+
+/*
+* Usage
+* -----
+* Lighter.Latency.Stats [Reset]
+* 		Input => Tracer & Input => Collision for the pointer & the gamepad, then every Source x Stage (See LighterInputLatency.h)
+* 		Count, avg / p50 / p99 / max ms & how many frames it took, since the last Reset
+*
+* Lighter.Latency.Dump [Name]
+* 		Same numbers to Saved/Profiling/TheLighter/Latency-<Name or Time>.csv, raw buckets in Latency-<...>-Histogram.csv
+* 		Diff two dumps (Before & after a tick order change) to catch a regression
+*/
+
+class FLighterLatencyDebug
+{
+public:
+	static ULighterBlockSubsystem* GetSubsystem(UWorld* World, FOutputDevice& Ar, const TCHAR* Command)
+	{
+		ULighterBlockSubsystem* subsystem = World && World->IsGameWorld() ? World->GetSubsystem<ULighterBlockSubsystem>() : nullptr;
+		if (!subsystem)
+			Ar.Logf(TEXT("%s needs a game world with a LighterBlockSubsystem"), Command);
+		return subsystem;
+	}
+
+	static void LogHistogram(const TCHAR* Label, const FLighterLatencyHistogram& Histogram, FOutputDevice& Ar)
+	{
+		uint64 totalFrames = 0;
+		FString frames;
+		for (int32 frame = 0; frame < FLighterLatencyHistogram::MaxFrames; ++frame)
+		{
+			totalFrames += (uint64)Histogram.Frames[frame] * frame;
+			if (Histogram.Frames[frame] > 0)
+				frames += FString::Printf(TEXT(" | %d%s: %u"), frame, frame == FLighterLatencyHistogram::MaxFrames - 1 ? TEXT("+") : TEXT(""), Histogram.Frames[frame]);
+		}
+
+		Ar.Logf(TEXT("%s => %llu | Avg %.2f ms, %.2f frames | P50 %.1f | P99 %.1f | Max %.2f ms%s"), Label, Histogram.Count,
+			Histogram.GetAverageMs(), Histogram.Count ? (double)totalFrames / Histogram.Count : 0.0,
+			Histogram.GetPercentileMs(50.f), Histogram.GetPercentileMs(99.f), Histogram.MaxMs, *frames);
+	}
+
+	static void Stats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		ULighterBlockSubsystem* subsystem = GetSubsystem(World, Ar, TEXT("Lighter.Latency.Stats"));
+		if (!subsystem) return;
+
+		FLighterInputLatency& latency = subsystem->GetInputLatency();
+		if (Args.Num() > 0 && Args[0] == TEXT("Reset"))
+		{
+			latency.Reset();
+			Ar.Logf(TEXT("Lighter.Latency.Stats reset"));
+			return;
+		}
+
+		Ar.Logf(TEXT("Input latency %s over %.1f s"), FLighterInputLatency::IsEnabled() ? TEXT("ON") : TEXT("OFF"), FPlatformTime::Seconds() - latency.GetStartTime());
+
+		// The two numbers the jumps & light flicks live or die by
+		const ELighterInputSource aimSources[] = { ELighterInputSource::Pointer, ELighterInputSource::Gamepad };
+		for (const ELighterInputSource source : aimSources)
+		{
+			LogHistogram(*FString::Printf(TEXT("%s => Tracer   "), FLighterInputLatency::GetName(source)), latency.GetHistogram(source, ELighterLatencyStage::Traced), Ar);
+			LogHistogram(*FString::Printf(TEXT("%s => Collision"), FLighterInputLatency::GetName(source)), latency.GetHistogram(source, ELighterLatencyStage::Simulated), Ar);
+		}
+
+		for (int32 source = 0; source < (int32)ELighterInputSource::Num; ++source)
+		{
+			Ar.Logf(TEXT("%s | %llu samples"), FLighterInputLatency::GetName((ELighterInputSource)source), latency.GetNumTraces((ELighterInputSource)source));
+			for (int32 stage = 0; stage < (int32)ELighterLatencyStage::Num; ++stage)
+			{
+				const FLighterLatencyHistogram& histogram = latency.GetHistogram((ELighterInputSource)source, (ELighterLatencyStage)stage);
+				if (histogram.Count > 0)
+					LogHistogram(*FString::Printf(TEXT("	%-9s"), FLighterInputLatency::GetName((ELighterLatencyStage)stage)), histogram, Ar);
+			}
+		}
+	}
+
+	static void Dump(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const ULighterBlockSubsystem* subsystem = GetSubsystem(World, Ar, TEXT("Lighter.Latency.Dump"));
+		if (!subsystem) return;
+
+		const FString name = Args.Num() > 0 ? Args[0] : FDateTime::Now().ToString();
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Latency-%s.csv"), *name);
+		if (subsystem->GetInputLatency().SaveToCsv(csvPath))
+			Ar.Logf(TEXT("Lighter.Latency.Dump written to %s"), *csvPath);
+		else
+			Ar.Logf(TEXT("Lighter.Latency.Dump FAILED to write %s"), *csvPath);
+	}
+};
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterLatencyStatsCommand(
+	TEXT("Lighter.Latency.Stats"),
+	TEXT("Lighter.Latency.Stats [Reset] => Input => Tracer / Collision / Contact latency histograms"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterLatencyDebug::Stats));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterLatencyDumpCommand(
+	TEXT("Lighter.Latency.Dump"),
+	TEXT("Lighter.Latency.Dump [Name] => Input latency summary & histograms to Saved/Profiling/TheLighter"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterLatencyDebug::Dump));
@@ -0,0 +1,73 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Console tooling for the replicated lit state
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Gameplay/LighterLitStateReplicator.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+
+
+/*
+* Usage
+* -----
+* Lighter.Net.Stats [Reset]
+* 		Lit state bandwidth (Bytes/s sent & received) & the server's CPU cost for it, since the last Reset
+* 		Sent is summed over every connection, so it grows with the player count
+*
+*
+* Listen server & clients on one Linux machine
+* --------------------------------------------
+* Server	=> TheLighter <Map>?listen -game -nullrhi -log
+* Client	=> TheLighter 127.0.0.1 -game -windowed -ResX=960 -ResY=540 -log		(As many as needed)
+* Then "Lighter.Net.Stats Reset" on the server, play for a while & "Lighter.Net.Stats"
+* "Net PktLoss=10" on a client exercises the delta fallback, "stat net" has the engine's totals
+*/
+
+class FLighterNetDebug
+{
+public:
+	static void Stats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		FLighterLitNetStats& stats = FLighterLitBits::GetStats();
+		if (Args.Num() > 0 && Args[0] == TEXT("Reset"))
+		{
+			stats.Reset();
+			Ar.Logf(TEXT("Lighter.Net.Stats reset"));
+			return;
+		}
+
+		const ALighterLitStateReplicator* replicator = nullptr;
+		if (World)
+			for (TActorIterator<ALighterLitStateReplicator> it(World); it; ++it)
+				replicator = *it;
+
+		if (!replicator)
+		{
+			Ar.Logf(TEXT("Lighter.Net.Stats needs a networked game (Listen server or client)"));
+			return;
+		}
+
+		const double seconds = FMath::Max(FPlatformTime::Seconds() - stats.StartTime, 0.001);
+		const double packMs = FPlatformTime::ToMilliseconds64(stats.PackCycles);
+		const double serializeMs = FPlatformTime::ToMilliseconds64(stats.SerializeCycles);
+		const ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+
+		Ar.Logf(TEXT("Lit state over %.1f s | %d blocks in net order%s | %d lit locally"),
+			seconds, replicator->GetNumNetBlocks(), replicator->DoesNetOrderMatch() ? TEXT("") : TEXT(" (DOESN'T MATCH THE SERVER)"), subsystem ? subsystem->GetNumLitBlocks() : 0);
+		Ar.Logf(TEXT("Sent %.1f B/s | %u deltas (%u full) | %.1f B per delta"),
+			stats.BitsSent / 8.0 / seconds, stats.Updates, stats.FullUpdates, stats.Updates ? stats.BitsSent / 8.0 / stats.Updates : 0.0);
+		Ar.Logf(TEXT("Received %.1f B/s | %u updates"),
+			stats.BitsReceived / 8.0 / seconds, stats.Received);
+		Ar.Logf(TEXT("Server CPU %.1f us/s | Pack %.2f us x %u | Serialize %.2f us per connection update"),
+			(packMs + serializeMs) * 1000.0 / seconds, stats.Packs ? packMs * 1000.0 / stats.Packs : 0.0, stats.Packs, stats.Updates ? serializeMs * 1000.0 / stats.Updates : 0.0);
+	}
+};
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterNetStatsCommand(
+	TEXT("Lighter.Net.Stats"),
+	TEXT("Lighter.Net.Stats [Reset] => Lit state bytes/s & server CPU cost"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterNetDebug::Stats));
@@ -0,0 +1,70 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Console tooling for the endless runner
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Gameplay/LighterRunnerPatterns.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+#include "LighterRunnerGameMode.h"
+
+
+/*
+* Usage
+* -----
+* Lighter.Runner.Soak [Minutes=60] [Speed=1500] [Quit=1]
+* 		Drives the balls down the run on their own & logs p50 / p99 frame time & memory every minute
+* 		Final percentiles & memory growth land in Saved/Profiling/TheLighter/Soak-<Time>.csv
+* 		Headless => TheLighter.exe <Map>?game=/Script/TheLighter.LighterRunnerGameMode -game -nullrhi -ExecCmds="Lighter.Runner.Soak 60"
+*
+* Lighter.Runner.Stats
+* 		Live / free pool blocks, patterns laid out so far (Per type) & rebases
+*/
+
+class FLighterRunnerDebug
+{
+public:
+	static ALighterRunnerGameMode* GetRunner(UWorld* World, FOutputDevice& Ar, const TCHAR* Command)
+	{
+		ALighterRunnerGameMode* runner = World && World->IsGameWorld() ? World->GetAuthGameMode<ALighterRunnerGameMode>() : nullptr;
+		if (!runner)
+			Ar.Logf(TEXT("%s needs a game world running LighterRunnerGameMode"), Command);
+		return runner;
+	}
+
+	static void Soak(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		ALighterRunnerGameMode* runner = GetRunner(World, Ar, TEXT("Lighter.Runner.Soak"));
+		if (!runner) return;
+
+		const float minutes = Args.Num() > 0 ? FMath::Max(0.1f, FCString::Atof(*Args[0])) : 60.f;
+		const float speed = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1500.f;
+		const bool bQuit = Args.Num() > 2 ? FCString::Atoi(*Args[2]) != 0 : true;
+		runner->StartSoak(minutes, speed, bQuit);
+	}
+
+	static void Stats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const ALighterRunnerGameMode* runner = GetRunner(World, Ar, TEXT("Lighter.Runner.Stats"));
+		if (!runner) return;
+
+		const ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		Ar.Logf(TEXT("Runner | Live %d | Free %d | Registered %d | Rebases %d | Soaking %s"),
+			runner->GetNumLiveBlocks(), runner->GetNumFreeBlocks(), subsystem ? subsystem->GetNumBlocks() : 0, runner->GetNumRebases(), runner->IsSoaking() ? TEXT("Yes") : TEXT("No"));
+
+		Ar.Logf(TEXT("Patterns %d"), runner->GetNumPatterns());
+		for (int32 i = 0; i < (int32)ELighterRunnerPattern::Num; ++i)
+			Ar.Logf(TEXT("	%s %d"), LighterRunnerPatterns::GetName((ELighterRunnerPattern)i), runner->GetNumPatterns((ELighterRunnerPattern)i));
+	}
+};
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterRunnerSoakCommand(
+	TEXT("Lighter.Runner.Soak"),
+	TEXT("Lighter.Runner.Soak [Minutes=60] [Speed=1500] [Quit=1] => Drives the run on its own & reports frame time percentiles & memory"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterRunnerDebug::Soak));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterRunnerStatsCommand(
+	TEXT("Lighter.Runner.Stats"),
+	TEXT("Runner pool usage, patterns laid out & rebases"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterRunnerDebug::Stats));
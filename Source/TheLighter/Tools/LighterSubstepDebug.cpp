@@ -0,0 +1,314 @@
+// Created by Vishal Naidu (GitHub: Vieper1) naiduvishal13@gmail.com | Vishal.Naidu@utah.edu
+// Headless tunnelling test for the substep tracer & the ball's CCD
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Tickable.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/SpotLightComponent.h"
+#include "Gameplay/TheLighterBall.h"
+#include "Gameplay/Block.h"
+#include "Gameplay/LighterBlockSubsystem.h"
+#include "TheLighter.h"
+
+
+/*
+* Usage
+* -----
+* Lighter.Substep.TunnelTest [MinSpeed=1000] [MaxSpeed=40000] [Step=1000] [FrameRate=30] [Quit=0]
+*
+* Headless on Linux:
+* 		UE4Editor-Cmd TheLighter.uproject /Game/TheLigher/Maps/TestGameplay -game -nullrhi -unattended -nosound
+* 			-ExecCmds="Lighter.Substep.TunnelTest 1000 40000 1000 30 1"
+*
+* Fires the first PlayerBall head on at a thin unlit LighterBlock (10 cm), SpotLight pointed at it, no gravity
+* Every speed from MinSpeed to MaxSpeed, at a fixed FrameRate, twice:
+* 		Before	=> Lighter.SubstepTracer 0 & no CCD on the ball (One trace a frame, the block has to be lit by then)
+* 		After	=> Lighter.SubstepTracer 1 & CCD on the ball
+*
+* Each trial
+* 1. Settle	=> Ball parked out of the Tracer's reach, block back to unlit
+* 2. Launch	=> Straight at the block at that speed
+* 3. Flight	=> Tunnelled (Past the far face) or Blocked (Stopped / bounced)
+*
+* Reports the lowest speed that tunnelled for both (The tunnelling threshold)
+* Per trial results go to Saved/Profiling/TheLighter/Tunnel-<Timestamp>.csv
+* Ball, block, cvars & the timestep go back to what they were when it's done
+*/
+
+class FLighterTunnelTest : public FTickableGameObject
+{
+public:
+	static void Run(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			Ar.Log(TEXT("Lighter.Substep.TunnelTest needs a game world"));
+			return;
+		}
+		if (Instance && Instance->IsTickable())
+		{
+			Ar.Log(TEXT("Lighter.Substep.TunnelTest is already running"));
+			return;
+		}
+
+		ULighterBlockSubsystem* subsystem = World->GetSubsystem<ULighterBlockSubsystem>();
+		UStaticMesh* mesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Game/Geometry/Meshes/1M_Cube.1M_Cube"));
+		IConsoleVariable* substepTracer = IConsoleManager::Get().FindConsoleVariable(TEXT("Lighter.SubstepTracer"));
+		ATheLighterBall* ball = subsystem && subsystem->GetBalls().Num() > 0 ? subsystem->GetBalls()[0] : nullptr;
+		if (!ball || !mesh || !substepTracer)
+		{
+			Ar.Log(TEXT("Lighter.Substep.TunnelTest couldn't find a PlayerBall, the block mesh or Lighter.SubstepTracer"));
+			return;
+		}
+
+		Instance = MakeUnique<FLighterTunnelTest>();
+		FLighterTunnelTest& test = *Instance;
+		test.MinSpeed = Args.Num() > 0 ? FMath::Max(1.f, FCString::Atof(*Args[0])) : 1000.f;
+		test.MaxSpeed = Args.Num() > 1 ? FMath::Max(test.MinSpeed, FCString::Atof(*Args[1])) : 40000.f;
+		test.SpeedStep = Args.Num() > 2 ? FMath::Max(1.f, FCString::Atof(*Args[2])) : 1000.f;
+		test.DeltaSeconds = 1.f / (Args.Num() > 3 ? FMath::Clamp(FCString::Atof(*Args[3]), 1.f, 1000.f) : 30.f);
+		test.bQuitWhenDone = Args.Num() > 4 && FCString::Atoi(*Args[4]) != 0;
+		test.Begin(World, ball, mesh, substepTracer);
+
+		Ar.Logf(TEXT("Lighter.Substep.TunnelTest %.0f => %.0f cm/s in %.0f steps at %.0f fps"), test.MinSpeed, test.MaxSpeed, test.SpeedStep, 1.f / test.DeltaSeconds);
+	}
+
+	virtual void Tick(float DeltaTime) override
+	{
+		ATheLighterBall* ball = Ball.Get();
+		if (!ball || !Block.IsValid())
+		{
+			UE_LOG(LogTheLighter, Error, TEXT("Lighter.Substep.TunnelTest FAILED => The ball or the block went away mid-test"));
+			Finish();
+			return;
+		}
+
+		UPrimitiveComponent* body = ball->GetMesh();
+		const float y = ball->GetActorLocation().Y;
+		++PhaseFrames;
+
+		switch (Phase)
+		{
+		case EPhase::Settle:
+			// Give the Tracer a few frames to let go of the last trial's block
+			body->SetPhysicsLinearVelocity(FVector::ZeroVector);
+			body->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+			if (PhaseFrames >= SettleFrames)
+			{
+				body->SetPhysicsLinearVelocity(FVector(0.f, Speed, 0.f));
+				SetPhase(EPhase::Flight);
+			}
+			break;
+
+		case EPhase::Flight:
+			if (y - BallRadius > FarFaceY)
+				EndTrial(true);
+			else if (body->GetPhysicsLinearVelocity().Y < Speed * 0.5f || PhaseFrames > MaxFlightFrames)
+				EndTrial(false);
+			break;
+		}
+	}
+
+	virtual bool IsTickable() const override { return !bFinished; }
+	virtual bool IsTickableWhenPaused() const override { return false; }
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(FLighterTunnelTest, STATGROUP_Tickables); }
+
+private:
+	enum class EPhase : uint8
+	{
+		Settle,
+		Flight
+	};
+
+	// Before & after, in that order
+	static constexpr int32 NumConfigs = 2;
+	static constexpr int32 SettleFrames = 4;
+
+	static TUniquePtr<FLighterTunnelTest> Instance;
+
+	TWeakObjectPtr<ATheLighterBall> Ball;
+	TWeakObjectPtr<ABlock> Block;
+	IConsoleVariable* SubstepTracer = nullptr;
+
+	float MinSpeed = 1000.f;
+	float MaxSpeed = 40000.f;
+	float SpeedStep = 1000.f;
+	float DeltaSeconds = 1.f / 30.f;
+	bool bQuitWhenDone = false;
+	bool bFinished = false;
+
+	FVector StartLocation;
+	float BallRadius = 0.f;
+	float FarFaceY = 0.f;
+	int32 MaxFlightFrames = 0;
+
+	int32 Config = 0;
+	float Speed = 0.f;
+	EPhase Phase = EPhase::Settle;
+	int32 PhaseFrames = 0;
+	float Thresholds[NumConfigs] = {};					// 0 => Never tunnelled
+	FString Csv;
+
+	// What the ball, the cvar & the timestep were before
+	struct FSavedState
+	{
+		bool bDisableTracerControl, bDisableMovement, bDisableAirControl, bDisableJump, bDisableExitImpulse;
+		bool bGravity, bCCD;
+		float GravityMultiplier;
+		FVector Location;
+		FRotator TargetTracerRotation;
+		int32 SubstepTracer;
+		bool bFixedTimeStep;
+		double FixedDeltaTime;
+	} Saved;
+
+	void Begin(UWorld* InWorld, ATheLighterBall* InBall, UStaticMesh* Mesh, IConsoleVariable* InSubstepTracer)
+	{
+		Ball = InBall;
+		SubstepTracer = InSubstepTracer;
+		UStaticMeshComponent* body = InBall->GetMesh();
+
+		Saved.bDisableTracerControl = InBall->bDisableTracerControl;
+		Saved.bDisableMovement = InBall->bDisableMovement;
+		Saved.bDisableAirControl = InBall->bDisableAirControl;
+		Saved.bDisableJump = InBall->bDisableJump;
+		Saved.bDisableExitImpulse = InBall->bDisableExitImpulse;
+		Saved.bGravity = body->IsGravityEnabled();
+		Saved.bCCD = body->BodyInstance.bUseCCD;
+		Saved.GravityMultiplier = InBall->GravityMultiplier;
+		Saved.Location = InBall->GetActorLocation();
+		Saved.TargetTracerRotation = InBall->TargetTracerRotation;
+		Saved.SubstepTracer = SubstepTracer->GetInt();
+		Saved.bFixedTimeStep = FApp::UseFixedTimeStep();
+		Saved.FixedDeltaTime = FApp::GetFixedDeltaTime();
+
+		// Straight line along +Y, nothing but the launch moving it
+		InBall->bDisableTracerControl = true;
+		InBall->bDisableMovement = true;
+		InBall->bDisableAirControl = true;
+		InBall->bDisableJump = true;
+		InBall->bDisableExitImpulse = true;
+		InBall->GravityMultiplier = 0.f;
+		body->SetEnableGravity(false);
+		InBall->TargetTracerRotation = FRotator(0.f, 90.f, 0.f);
+		InBall->SpotLight->SetWorldRotation(InBall->TargetTracerRotation);
+
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(DeltaSeconds);
+
+		// Out of the Tracer's reach at the start, so the block is unlit when the ball takes off
+		StartLocation = Saved.Location;
+		BallRadius = body->Bounds.SphereRadius;
+		const float startDistance = FMath::Max(InBall->TraceLength * 1.5f, 500.f) + BallRadius;
+		const FTransform blockTransform(FRotator::ZeroRotator, StartLocation + FVector(0.f, startDistance, 0.f), FVector(1.f, 0.1f, 6.f));
+
+		ABlock* block = InWorld->SpawnActorDeferred<ABlock>(ABlock::StaticClass(), blockTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		block->MeshComp->SetStaticMesh(Mesh);
+		block->FinishSpawning(blockTransform);
+		Block = block;
+		FarFaceY = block->GetBounds2D().Max.X;
+
+		Csv = TEXT("Config,Speed,FrameTravel,Result,Frames\n");
+		BeginConfig(0);
+	}
+
+	void BeginConfig(const int32 InConfig)
+	{
+		Config = InConfig;
+		const bool bAfter = Config == 1;
+		SubstepTracer->Set(bAfter ? 1 : 0, ECVF_SetByCode);
+		Ball->GetMesh()->SetUseCCD(bAfter);
+		BeginTrial(MinSpeed);
+	}
+
+	void BeginTrial(const float InSpeed)
+	{
+		Speed = InSpeed;
+		MaxFlightFrames = FMath::CeilToInt((FarFaceY - StartLocation.Y) * 2.f / (Speed * DeltaSeconds)) + 30;
+		Ball->SetActorLocation(StartLocation, false, nullptr, ETeleportType::TeleportPhysics);
+		SetPhase(EPhase::Settle);
+	}
+
+	void SetPhase(const EPhase InPhase)
+	{
+		Phase = InPhase;
+		PhaseFrames = 0;
+	}
+
+	void EndTrial(const bool bTunnelled)
+	{
+		const TCHAR* configName = Config == 0 ? TEXT("Before") : TEXT("After");
+		const FString line = FString::Printf(TEXT("%s,%.0f,%.1f,%s,%d"), configName, Speed, Speed * DeltaSeconds, bTunnelled ? TEXT("Tunnelled") : TEXT("Blocked"), PhaseFrames);
+		UE_LOG(LogTheLighter, Log, TEXT("Lighter.Substep.TunnelTest %s"), *line);
+		Csv += line + TEXT("\n");
+
+		if (bTunnelled && Thresholds[Config] == 0.f)
+			Thresholds[Config] = Speed;
+
+		if (Speed + SpeedStep <= MaxSpeed + KINDA_SMALL_NUMBER)
+			BeginTrial(Speed + SpeedStep);
+		else if (Config + 1 < NumConfigs)
+			BeginConfig(Config + 1);
+		else
+			Finish();
+	}
+
+	void Finish()
+	{
+		bFinished = true;
+
+		for (int32 config = 0; config < NumConfigs; ++config)
+		{
+			const TCHAR* configName = config == 0 ? TEXT("Before (One trace a frame, no CCD)") : TEXT("After (Substep tracer & CCD)");
+			if (Thresholds[config] > 0.f)
+				UE_LOG(LogTheLighter, Log, TEXT("Lighter.Substep.TunnelTest %s => Tunnels from %.0f cm/s (%.1f cm a frame)"), configName, Thresholds[config], Thresholds[config] * DeltaSeconds);
+			else
+				UE_LOG(LogTheLighter, Log, TEXT("Lighter.Substep.TunnelTest %s => No tunnelling up to %.0f cm/s"), configName, MaxSpeed);
+		}
+
+		const FString csvPath = FPaths::ProfilingDir() / TEXT("TheLighter") / FString::Printf(TEXT("Tunnel-%s.csv"), *FDateTime::Now().ToString());
+		if (FFileHelper::SaveStringToFile(Csv, *csvPath))
+			UE_LOG(LogTheLighter, Log, TEXT("Lighter.Substep.TunnelTest results written to %s"), *csvPath);
+
+		if (ATheLighterBall* ball = Ball.Get())
+		{
+			UStaticMeshComponent* body = ball->GetMesh();
+			ball->bDisableTracerControl = Saved.bDisableTracerControl;
+			ball->bDisableMovement = Saved.bDisableMovement;
+			ball->bDisableAirControl = Saved.bDisableAirControl;
+			ball->bDisableJump = Saved.bDisableJump;
+			ball->bDisableExitImpulse = Saved.bDisableExitImpulse;
+			ball->GravityMultiplier = Saved.GravityMultiplier;
+			ball->TargetTracerRotation = Saved.TargetTracerRotation;
+			body->SetEnableGravity(Saved.bGravity);
+			body->SetUseCCD(Saved.bCCD);
+			ball->SetActorLocation(Saved.Location, false, nullptr, ETeleportType::TeleportPhysics);
+			body->SetPhysicsLinearVelocity(FVector::ZeroVector);
+		}
+		if (ABlock* block = Block.Get())
+			block->Destroy();
+
+		SubstepTracer->Set(Saved.SubstepTracer, ECVF_SetByCode);
+		FApp::SetUseFixedTimeStep(Saved.bFixedTimeStep);
+		FApp::SetFixedDeltaTime(Saved.FixedDeltaTime);
+
+		if (bQuitWhenDone && GEngine)
+			GEngine->DeferredCommands.Add(TEXT("quit"));
+	}
+};
+
+TUniquePtr<FLighterTunnelTest> FLighterTunnelTest::Instance;
+
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice LighterSubstepTunnelTestCommand(
+	TEXT("Lighter.Substep.TunnelTest"),
+	TEXT("Lighter.Substep.TunnelTest [MinSpeed=1000] [MaxSpeed=40000] [Step=1000] [FrameRate=30] [Quit=0] => Tunnelling threshold with & without the substep tracer & CCD"),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&FLighterTunnelTest::Run));